@@ -5,6 +5,10 @@
 #include <type_traits>
 #include "BF/Definitions.hpp"
 
+#if defined(_M_X64) && !defined(__SIZEOF_INT128__)
+	#include <intrin.h>
+#endif
+
 
 namespace BF {
 
@@ -39,4 +43,47 @@ constexpr bool IsPowerOf2(UInt64 n)
 }
 
 
+// === UMul128() =======================================================================================================
+// Full 64 x 64 -> 128 bit multiplication. Returns the low half, and stores the high half in 'high'.
+
+constexpr UInt64 UMul128(UInt64 a, UInt64 b, UInt64& high)
+{
+#if defined(__SIZEOF_INT128__)
+	const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+	high = static_cast<UInt64>(product >> 64);
+	return static_cast<UInt64>(product);
+#else
+	#if defined(_M_X64)
+		if !consteval {
+			return _umul128(a, b, &high);
+		}
+	#endif
+
+	const UInt64 aLo = a & MaxUInt32, aHi = a >> 32;
+	const UInt64 bLo = b & MaxUInt32, bHi = b >> 32;
+
+	const UInt64 loLo = aLo * bLo;
+	const UInt64 hiLo = aHi * bLo;
+	const UInt64 loHi = aLo * bHi;
+	const UInt64 hiHi = aHi * bHi;
+
+	const UInt64 middle = (loLo >> 32) + (hiLo & MaxUInt32) + loHi;		// cannot overflow
+
+	high = hiHi + (hiLo >> 32) + (middle >> 32);
+	return (middle << 32) | (loLo & MaxUInt32);
+#endif
+}
+
+
+// === UMul128Fold() ===================================================================================================
+// XOR of the two halves of the 128 bit product. Every input bit affects every output bit.
+
+constexpr UInt64 UMul128Fold(UInt64 a, UInt64 b)
+{
+	UInt64 high = 0;
+	const UInt64 low = UMul128(a, b, high);
+	return low ^ high;
+}
+
+
 }	// namespace BF
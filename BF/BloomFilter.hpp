@@ -0,0 +1,175 @@
+// A probabilistic set membership filter. 'MayContain()' never returns false for an inserted value, but it can return
+// true for a value that was not inserted, with a configurable probability.
+
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <span>
+#include <vector>
+#include "BF/Assert.hpp"
+#include "BF/Hash.hpp"
+
+
+namespace BF {
+
+
+// === class BloomFilter ===============================================================================================
+// Cache line blocked: the high bits of the hash select a 512 bit block, all probed bits of a value are in this block.
+// Thus a query touches a single cache line. The bit positions inside the block come from the other half of the same
+// hash, remixed by a multiplication for every probe, so 'std::hash' is called once per value. (Classic double hashing
+// 'h1 + i * h2' produces correlated positions in a block this small, the false positive rate would be much higher.) The
+// probed bits are collected into a mask of eight words first, then the block is tested against the mask in one loop,
+// which the compiler can vectorize.
+//
+// Blocking makes the false positive rate higher than for a classic Bloom filter, because the number of values per block
+// varies. The size is increased until the expected rate of the blocked filter reaches the requested one. The serialized
+// bytes can only be read back by a filter with the same 'Hasher' (e.g. 'std::hash' of strings is different on different
+// platforms) and the same byte order.
+
+template <class Type, class Hasher = std::hash<Type>>
+class BloomFilter {
+	static_assert(StdHashable<Type> || !std::is_same_v<Hasher, std::hash<Type>>, "'Type' is not hashable.");
+
+public:
+	BloomFilter(std::size_t expectedCount, double falsePositiveRate) {
+		BF_ASSERT(falsePositiveRate > 0 && falsePositiveRate < 1);
+
+		const double ln2        = std::log(2.0);
+		double       bitsPerKey = std::max(-std::log(falsePositiveRate) / (ln2 * ln2), 1.0);		// optimal for a classic filter
+
+		const auto getProbeCount = [&] { return std::clamp(static_cast<int>(std::lround(bitsPerKey * ln2)), 1, MaxProbeCount); };
+		while (GetExpectedFalsePositiveRate(bitsPerKey, getProbeCount()) > falsePositiveRate && bitsPerKey < BlockBits)
+			bitsPerKey *= 1.02;
+
+		const std::size_t totalBits = static_cast<std::size_t>(std::ceil(bitsPerKey * static_cast<double>(std::max<std::size_t>(expectedCount, 1))));
+
+		mBlocks.resize((totalBits + BlockBits - 1) / BlockBits);
+		BF_ASSERT(mBlocks.size() <= MaxBlockCount);
+		mProbeCount = getProbeCount();
+	}
+
+	BloomFilter(std::span<const std::byte> bytes, int probeCount) :		// reads the result of 'GetBytes()'
+		mBlocks(bytes.size() / sizeof(Block)),
+		mProbeCount(probeCount)
+	{
+		BF_ASSERT(!bytes.empty() && bytes.size() % sizeof(Block) == 0 && mBlocks.size() <= MaxBlockCount);
+		BF_ASSERT(probeCount >= 1 && probeCount <= MaxProbeCount);
+
+		std::memcpy(mBlocks.data(), bytes.data(), mBlocks.size() * sizeof(Block));
+	}
+
+	void Insert(const Type& value) {
+		InsertHash(GetHash(value));
+	}
+
+	bool MayContain(const Type& value) const {
+		return MayContainHash(GetHash(value));
+	}
+
+	void InsertMany(std::span<const Type> values) {
+		ForEachHash(values, [this](std::size_t, UInt64 hash) { InsertHash(hash); });
+	}
+
+	void MayContainMany(std::span<const Type> values, std::span<bool> results) const {
+		BF_ASSERT(values.size() == results.size());
+		ForEachHash(values, [this, results](std::size_t i, UInt64 hash) { results[i] = MayContainHash(hash); });
+	}
+
+	std::span<const std::byte> GetBytes() const {
+		return std::as_bytes(std::span(mBlocks));
+	}
+
+	int GetProbeCount() const {
+		return mProbeCount;
+	}
+
+private:
+	constexpr static std::size_t BlockBits     = 512;
+	constexpr static std::size_t WordCount     = BlockBits / 64;
+	constexpr static int         MaxProbeCount = 16;
+	constexpr static std::size_t HashBlockSize = 16;
+	constexpr static UInt64      MaxBlockCount = UInt64(1) << 32;		// see 'GetBlockIndex()'
+
+	struct alignas(64) Block {
+		UInt64 words[WordCount];
+	};
+
+	// The number of values in a block has a Poisson distribution. For 'count' values in a block, a bit is set with
+	// probability 1 - (1 - 1/BlockBits)^(probeCount * count).
+	static double GetExpectedFalsePositiveRate(double bitsPerKey, int probeCount) {
+		const double meanCount = BlockBits / bitsPerKey;
+
+		double rate        = 0;
+		double probability = std::exp(-meanCount);
+		for (int count = 0; count < 2 * meanCount + 100; count++) {
+			const double bitSet = 1 - std::pow(1 - 1.0 / BlockBits, probeCount * count);
+			rate        += probability * std::pow(bitSet, probeCount);
+			probability *= meanCount / (count + 1);
+		}
+
+		return rate;
+	}
+
+	UInt64 GetHash(const Type& value) const {
+		return FMix64(static_cast<UInt64>(mHasher(value)));
+	}
+
+	// First all hashes of a group of values are computed, then the (independent) memory accesses follow.
+	template <class Func>
+	void ForEachHash(std::span<const Type> values, Func func) const {
+		for (std::size_t i = 0; i < values.size(); i += HashBlockSize) {
+			const std::size_t count = std::min(HashBlockSize, values.size() - i);
+
+			UInt64 hashes[HashBlockSize];
+			for (std::size_t j = 0; j < count; j++)
+				hashes[j] = GetHash(values[i + j]);
+
+			for (std::size_t j = 0; j < count; j++)
+				func(i + j, hashes[j]);
+		}
+	}
+
+	std::size_t GetBlockIndex(UInt64 hash) const {
+		return static_cast<std::size_t>(((hash >> 32) * mBlocks.size()) >> 32);
+	}
+
+	Block GetMask(UInt64 hash) const {
+		Block  mask = {};
+		UInt32 h    = static_cast<UInt32>(hash);
+		for (int i = 0; i < mProbeCount; i++) {
+			const UInt32 bit = h >> (32 - 9);							// the highest 9 bits, 'BlockBits' is 512
+			mask.words[bit / 64] |= UInt64(1) << (bit % 64);
+			h *= 0x9e3779b9;
+		}
+
+		return mask;
+	}
+
+	void InsertHash(UInt64 hash) {
+		Block&      block = mBlocks[GetBlockIndex(hash)];
+		const Block mask  = GetMask(hash);
+
+		for (std::size_t w = 0; w < WordCount; w++)
+			block.words[w] |= mask.words[w];
+	}
+
+	bool MayContainHash(UInt64 hash) const {
+		const Block& block = mBlocks[GetBlockIndex(hash)];
+		const Block  mask  = GetMask(hash);
+
+		UInt64 missing = 0;
+		for (std::size_t w = 0; w < WordCount; w++)
+			missing |= mask.words[w] & ~block.words[w];
+
+		return missing == 0;
+	}
+
+	std::vector<Block> mBlocks;
+	int                mProbeCount = 1;
+	Hasher             mHasher;
+};
+
+
+}	// namespace BF
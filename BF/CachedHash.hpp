@@ -0,0 +1,97 @@
+// A value together with its hash value, for keys which are expensive to hash.
+
+
+#pragma once
+#include <utility>
+#include "BF/Definitions.hpp"
+#include "BF/Hash.hpp"
+
+
+namespace BF {
+
+
+// === class CachedHash ================================================================================================
+// The hash value is computed once, at construction (and after 'Modify()'), with 'Hasher'. Rehashing a container and
+// looking up the same key object again don't call 'Hasher'. 'std::hash<CachedHash<Type>>' returns the same value as
+// 'Hasher' for the wrapped value, so the wrapper doesn't change bucket positions, and it can be a member in
+// 'BF_GetHash()' of other types. Comparison checks the cached hash values first, the values are compared only if the
+// hash values are equal. The hash values are only compared if the hashers are known to be equal ('Hasher' is empty, or
+// their 'GetSeed()' values or the hashers themselves compare equal), so values hashed with different seeds still
+// compare equal.
+//
+// The wrapped value can't be modified in place, only via 'Modify()', which recomputes the hash value. A stateful hasher
+// (e.g. a 'BF::SeededHasher' with its own seed) is passed to the constructor, and it is stored for 'Modify()'. The
+// in-place constructor uses a default constructed 'Hasher'.
+
+template <class Type, class Hasher = std::hash<Type>>
+class CachedHash {
+	static_assert(StdHashable<Type> || !std::is_same_v<Hasher, std::hash<Type>>, "'Type' is not hashable.");
+
+public:
+	template <class... Pars>
+	explicit CachedHash(std::in_place_t, Pars&&... pars) :
+		mValue(BF_FWD(pars)...),
+		mHash(mHasher(mValue))
+	{
+	}
+
+	CachedHash(const Type& value, const Hasher& hasher = Hasher()) :
+		mValue(value),
+		mHasher(hasher),
+		mHash(mHasher(mValue))
+	{
+	}
+
+	CachedHash(Type&& value, const Hasher& hasher = Hasher()) :
+		mValue(std::move(value)),
+		mHasher(hasher),
+		mHash(mHasher(mValue))
+	{
+	}
+
+	const Type& Get() const        { return mValue; }
+	const Type& operator*() const  { return mValue; }
+	const Type* operator->() const { return &mValue; }
+
+	std::size_t GetHashValue() const {
+		return mHash;
+	}
+
+	// Calls 'func(Type&)', then recomputes the hash value.
+	template <class Func>
+	void Modify(Func&& func) {
+		func(mValue);
+		mHash = mHasher(mValue);
+	}
+
+	Hash BF_GetHash() const {
+		return Hash::FromValue(mHash);
+	}
+
+	bool operator==(const CachedHash& other) const {
+		if (HasSameHasher(other) && mHash != other.mHash)
+			return false;
+
+		return mValue == other.mValue;
+	}
+
+private:
+	// The hash values are only comparable if they were computed by equal hashers.
+	bool HasSameHasher(const CachedHash& other) const {
+		if constexpr (std::is_empty_v<Hasher>)
+			return true;
+		else if constexpr (requires { { mHasher.GetSeed() } -> std::equality_comparable; })
+			return mHasher.GetSeed() == other.mHasher.GetSeed();
+		else if constexpr (std::equality_comparable<Hasher>)
+			return mHasher == other.mHasher;
+		else
+			return false;
+	}
+
+	Type        mValue;
+	Hasher      mHasher;
+	std::size_t mHash;
+};
+
+
+}	// namespace BF
@@ -0,0 +1,205 @@
+// A hash map, which can be used from multiple threads at the same time. It is split into shards, each of them has its
+// own lock, so threads working on different shards don't wait for each other.
+
+
+#pragma once
+#include <array>
+#include <bit>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <shared_mutex>
+#include "BF/ClassUtils.hpp"
+#include "BF/FlatHashMap.hpp"
+
+
+namespace BF {
+
+
+// === Implementation details ==========================================================================================
+
+namespace ImpConcurrentHashMap {
+
+
+// The key is hashed once, for selecting the shard. The shard's map receives the key together with this hash, so it
+// doesn't hash the key again. Only inserting a new key and rehashing hashes a plain 'Key'.
+template <class Key>
+struct HashedKey {
+	const Key&  key;
+	std::size_t hash;
+};
+
+
+template <class Key, class Hasher>
+struct ShardHasher {
+	using is_transparent = void;
+
+	std::size_t operator()(const Key& key) const             { return hasher(key); }
+	std::size_t operator()(const HashedKey<Key>& key) const { return key.hash; }
+
+	Hasher hasher;
+};
+
+
+template <class Key, class KeyEqual>
+struct ShardKeyEqual {
+	using is_transparent = void;
+
+	bool operator()(const Key& leftOp, const Key& rightOp) const             { return keyEqual(leftOp, rightOp); }
+	bool operator()(const Key& leftOp, const HashedKey<Key>& rightOp) const { return keyEqual(leftOp, rightOp.key); }
+
+	KeyEqual keyEqual;
+};
+
+
+}	// namespace ImpConcurrentHashMap
+
+
+// === class ConcurrentHashMap =========================================================================================
+// The high bits of the (mixed) hash select the shard, the shard's 'BF::FlatHashMap' uses the low bits. Lookups take a
+// shared lock, modifications an exclusive lock of one shard. Values are returned by copy, or can be accessed by a
+// visitor while the lock is held. References to the elements are never handed out, they could be invalidated by
+// another thread at any time.
+
+template <class Key, class Value, class Hasher = std::hash<Key>, class KeyEqual = std::equal_to<Key>, std::size_t ShardCount = 64>
+class ConcurrentHashMap : ImmobileClass {
+	static_assert(IsPowerOf2(ShardCount), "'ShardCount' must be a power of 2.");
+
+	using HashedKey = ImpConcurrentHashMap::HashedKey<Key>;
+	using ShardMap  = FlatHashMap<Key, Value, ImpConcurrentHashMap::ShardHasher<Key, Hasher>, ImpConcurrentHashMap::ShardKeyEqual<Key, KeyEqual>>;
+
+public:
+	ConcurrentHashMap() = default;
+
+	explicit ConcurrentHashMap(std::size_t capacity) {
+		for (Shard& shard : mShards)
+			shard.map.Reserve((capacity + ShardCount - 1) / ShardCount);
+	}
+
+	std::optional<Value> Find(const Key& key) const {
+		const HashedKey hashedKey = MakeHashedKey(key);
+		const Shard&    shard     = GetShard(hashedKey);
+
+		std::shared_lock lock(shard.mutex);
+		const auto it = shard.map.Find(hashedKey);
+		return it != shard.map.end() ? std::optional<Value>(it->second) : std::nullopt;
+	}
+
+	bool Contains(const Key& key) const {
+		const HashedKey hashedKey = MakeHashedKey(key);
+		const Shard&    shard     = GetShard(hashedKey);
+
+		std::shared_lock lock(shard.mutex);
+		return shard.map.Contains(hashedKey);
+	}
+
+	// Calls 'visitor(const Value&)' under a shared lock. Returns false if the key is not found.
+	template <class Visitor>
+	bool Visit(const Key& key, Visitor&& visitor) const {
+		const HashedKey hashedKey = MakeHashedKey(key);
+		const Shard&    shard     = GetShard(hashedKey);
+
+		std::shared_lock lock(shard.mutex);
+		const auto it = shard.map.Find(hashedKey);
+		if (it == shard.map.end())
+			return false;
+
+		visitor(std::as_const(it->second));
+		return true;
+	}
+
+	// Calls 'visitor(Value&)' under an exclusive lock. Returns false if the key is not found.
+	template <class Visitor>
+	bool Update(const Key& key, Visitor&& visitor) {
+		const HashedKey hashedKey = MakeHashedKey(key);
+		Shard&          shard     = GetShard(hashedKey);
+
+		std::unique_lock lock(shard.mutex);
+		const auto it = shard.map.Find(hashedKey);
+		if (it == shard.map.end())
+			return false;
+
+		visitor(it->second);
+		return true;
+	}
+
+	// Calls 'visitor(const Key&, const Value&)' for all elements, one shard at a time. Elements which are inserted or
+	// erased concurrently may or may not be visited.
+	template <class Visitor>
+	void VisitAll(Visitor&& visitor) const {
+		for (const Shard& shard : mShards) {
+			std::shared_lock lock(shard.mutex);
+			for (const auto& [key, value] : shard.map)
+				visitor(key, value);
+		}
+	}
+
+	// Returns true if the key was inserted, false if it was assigned.
+	template <class Par>
+	bool InsertOrAssign(const Key& key, Par&& value) {
+		const HashedKey hashedKey = MakeHashedKey(key);
+		Shard&          shard     = GetShard(hashedKey);
+
+		std::unique_lock lock(shard.mutex);
+		if (const auto it = shard.map.Find(hashedKey); it != shard.map.end()) {
+			it->second = BF_FWD(value);
+			return false;
+		}
+
+		shard.map.TryEmplace(key, BF_FWD(value));
+		return true;
+	}
+
+	bool Erase(const Key& key) {
+		const HashedKey hashedKey = MakeHashedKey(key);
+		Shard&          shard     = GetShard(hashedKey);
+
+		std::unique_lock lock(shard.mutex);
+		return shard.map.Erase(hashedKey) != 0;
+	}
+
+	std::size_t GetSize() const {								// not a snapshot, if other threads are modifying the map
+		std::size_t size = 0;
+		for (const Shard& shard : mShards) {
+			std::shared_lock lock(shard.mutex);
+			size += shard.map.GetSize();
+		}
+
+		return size;
+	}
+
+	void Clear() {
+		for (Shard& shard : mShards) {
+			std::unique_lock lock(shard.mutex);
+			shard.map.Clear();
+		}
+	}
+
+private:
+	struct alignas(std::hardware_destructive_interference_size) Shard {		// no false sharing between the locks
+		mutable std::shared_mutex mutex;
+		ShardMap                  map;
+	};
+
+	constexpr static int ShardBits = std::countr_zero(ShardCount);
+
+	HashedKey MakeHashedKey(const Key& key) const {
+		return { key, static_cast<std::size_t>(mHasher(key)) };
+	}
+
+	static std::size_t GetShardIndex(const HashedKey& hashedKey) {
+		if constexpr (ShardBits == 0)
+			return 0;
+		else
+			return static_cast<std::size_t>(FMix64(hashedKey.hash) >> (64 - ShardBits));
+	}
+
+	const Shard& GetShard(const HashedKey& hashedKey) const { return mShards[GetShardIndex(hashedKey)]; }
+	Shard&       GetShard(const HashedKey& hashedKey)       { return mShards[GetShardIndex(hashedKey)]; }
+
+	Hasher                        mHasher;
+	std::array<Shard, ShardCount> mShards;
+};
+
+
+}	// namespace BF
@@ -0,0 +1,117 @@
+// Assigning keys to shards, so that only a few keys move to another shard when shards are added or removed.
+// The keys are hashed through 'BF::Hash' or 'std::hash'. Placements are only reproducible by processes that compute the
+// same hash values, e.g. instances of the same binary.
+
+
+#pragma once
+#include <cmath>
+#include <span>
+#include <vector>
+#include "BF/Assert.hpp"
+#include "BF/Hash.hpp"
+
+
+namespace BF {
+
+
+// === JumpConsistentHash() ============================================================================================
+// https://arxiv.org/abs/1406.2294 (John Lamping, Eric Veach: A Fast, Minimal Memory, Consistent Hash Algorithm)
+// Returns a bucket in [0, bucketCount). When 'bucketCount' grows by one, a key either stays in its bucket, or moves to
+// the new one, and 1 / bucketCount of the keys move. No state, O(log bucketCount) time. Buckets can only be added or
+// removed at the end.
+
+constexpr UInt32 JumpConsistentHash(UInt64 key, UInt32 bucketCount)
+{
+	BF_ASSERT(bucketCount > 0);
+
+	Int64 bucket = -1;
+	Int64 next   = 0;
+	while (next < bucketCount) {
+		bucket = next;
+		key    = key * 2862933555777941757 + 1;
+		next   = static_cast<Int64>(static_cast<double>(bucket + 1) * (static_cast<double>(Int64(1) << 31) / static_cast<double>((key >> 33) + 1)));
+	}
+
+	return static_cast<UInt32>(bucket);
+}
+
+
+template <HashCombinatorPolicy Combinator>
+UInt32 JumpConsistentHash(const BasicHash<Combinator>& hash, UInt32 bucketCount)
+{
+	return JumpConsistentHash(static_cast<UInt64>(std::hash<BasicHash<Combinator>>()(hash)), bucketCount);
+}
+
+
+// === class RendezvousSelector ========================================================================================
+// Weighted rendezvous (highest random weight) hashing. Every node gets a score for a key: weight / -ln(u), where 'u' is
+// a uniform random number in (0, 1) derived from the key hash and the node hash. The node with the highest score is
+// selected. A node gets keys in proportion to its weight. Adding a node only moves keys to the new node, removing a
+// node only moves the keys of that node. Nodes can be added and removed anywhere, but a selection costs O(nodes).
+
+template <class Node, class Hasher = std::hash<Node>>
+class RendezvousSelector {
+	static_assert(StdHashable<Node> || !std::is_same_v<Hasher, std::hash<Node>>, "'Node' is not hashable.");
+
+public:
+	void Add(const Node& node, double weight = 1.0) {
+		BF_ASSERT(weight > 0);
+		mNodes.push_back({ node, FMix64(static_cast<UInt64>(mHasher(node))), weight });
+	}
+
+	bool Remove(const Node& node) {
+		for (auto it = mNodes.begin(); it != mNodes.end(); ++it) {
+			if (it->node == node) {
+				mNodes.erase(it);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	std::size_t GetSize() const {
+		return mNodes.size();
+	}
+
+	const Node& Select(UInt64 keyHash) const {					// 'keyHash' is a 'std::hash' value of the key
+		BF_ASSERT(!mNodes.empty());
+
+		const NodeData* best      = &mNodes[0];
+		double          bestScore = GetScore(keyHash, mNodes[0]);
+		for (std::size_t i = 1; i < mNodes.size(); i++) {
+			const double score = GetScore(keyHash, mNodes[i]);
+			if (score > bestScore) {
+				best      = &mNodes[i];
+				bestScore = score;
+			}
+		}
+
+		return best->node;
+	}
+
+	template <HashCombinatorPolicy Combinator>
+	const Node& Select(const BasicHash<Combinator>& keyHash) const {
+		return Select(static_cast<UInt64>(std::hash<BasicHash<Combinator>>()(keyHash)));
+	}
+
+private:
+	struct NodeData {
+		Node   node;
+		UInt64 hash;
+		double weight;
+	};
+
+	static double GetScore(UInt64 keyHash, const NodeData& node) {
+		const UInt64 mixed = FMix64(keyHash ^ node.hash);
+		const double u     = (static_cast<double>(mixed >> 11) + 0.5) * 0x1.0p-53;		// in (0, 1)
+
+		return node.weight / -std::log(u);
+	}
+
+	std::vector<NodeData> mNodes;
+	Hasher                mHasher;
+};
+
+
+}	// namespace BF
@@ -0,0 +1,98 @@
+// Splitting data into chunks at positions chosen by the content, e.g. for deduplication. Inserting or removing bytes
+// only changes the chunks around the edit, the later boundaries stay at the same content.
+
+
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <span>
+#include "BF/Assert.hpp"
+#include "BF/RollingHash.hpp"
+
+
+namespace BF {
+
+
+// === class ContentDefinedChunker =====================================================================================
+// https://www.usenix.org/conference/atc16/technical-sessions/presentation/xia (Wen Xia et al.: FastCDC)
+// A Gear hash runs over the bytes: every step shifts it left by one and adds the table value of the next byte, so its
+// high bits depend on the last 64 bytes. A chunk ends where enough high bits are zero. The first 'minSize' bytes of a
+// chunk are skipped. Until 'averageSize', log2(averageSize) + 2 bits have to be zero, after that log2(averageSize) - 2
+// bits, so the chunk sizes are concentrated around 'averageSize'. A chunk is cut at 'maxSize' anyway. One shift, one
+// add, one table lookup and one test per byte.
+//
+//     BF::ContentDefinedChunker chunker(2048, 8192, 65536);
+//     chunker.ForEachChunk(bytes, [&](std::span<const std::byte> chunk) { store.Add(BF::HashBytes(chunk), chunk); });
+//
+// For streamed data, call 'FindBoundary()' on the buffered bytes, with at least 'maxSize' bytes buffered unless the
+// stream has ended, and drop the returned number of bytes from the front of the buffer.
+
+class ContentDefinedChunker {
+public:
+	constexpr ContentDefinedChunker(std::size_t minSize, std::size_t averageSize, std::size_t maxSize) :
+		mMinSize(minSize),
+		mAverageSize(averageSize),
+		mMaxSize(maxSize),
+		mSmallMask(MakeMask(std::bit_width(averageSize) - 1 + NormalizationLevel)),
+		mLargeMask(MakeMask(std::bit_width(averageSize) - 1 - NormalizationLevel))
+	{
+		BF_ASSERT(0 < minSize && minSize <= averageSize && averageSize <= maxSize);
+		BF_ASSERT(averageSize >= 8);
+	}
+
+	// Returns the size of the first chunk of 'data', at most 'maxSize'. If 'data' is shorter than 'maxSize' and has no
+	// boundary, returns 'data.size()'.
+	constexpr std::size_t FindBoundary(std::span<const std::byte> data) const {
+		if (data.size() <= mMinSize)
+			return data.size();
+
+		const std::size_t end    = std::min(data.size(), mMaxSize);
+		const std::size_t middle = std::min(end, mAverageSize);
+
+		UInt64      hash = 0;
+		std::size_t i    = mMinSize;
+		for (; i < middle; i++) {
+			hash = (hash << 1) + ImpHash::ByteTable[static_cast<UInt8>(data[i])];
+			if ((hash & mSmallMask) == 0)
+				return i + 1;
+		}
+
+		for (; i < end; i++) {
+			hash = (hash << 1) + ImpHash::ByteTable[static_cast<UInt8>(data[i])];
+			if ((hash & mLargeMask) == 0)
+				return i + 1;
+		}
+
+		return end;
+	}
+
+	// Calls 'func(std::span<const std::byte>)' for every chunk of 'data', in order.
+	template <class Func>
+	constexpr void ForEachChunk(std::span<const std::byte> data, Func&& func) const {
+		while (!data.empty()) {
+			const std::size_t size = FindBoundary(data);
+			func(data.first(size));
+			data = data.subspan(size);
+		}
+	}
+
+	constexpr std::size_t GetMinSize() const     { return mMinSize; }
+	constexpr std::size_t GetAverageSize() const { return mAverageSize; }
+	constexpr std::size_t GetMaxSize() const     { return mMaxSize; }
+
+private:
+	constexpr static int NormalizationLevel = 2;
+
+	constexpr static UInt64 MakeMask(int bitCount) {					// the high bits depend on the most bytes
+		return ~(MaxUInt64 >> bitCount);
+	}
+
+	std::size_t mMinSize;
+	std::size_t mAverageSize;
+	std::size_t mMaxSize;
+	UInt64      mSmallMask;
+	UInt64      mLargeMask;
+};
+
+
+}	// namespace BF
@@ -0,0 +1,88 @@
+// Estimating the frequencies of values in a stream, with a fixed amount of memory.
+
+
+#pragma once
+#include <algorithm>
+#include <vector>
+#include "BF/Hash.hpp"
+
+
+namespace BF {
+
+
+// === class CountMinSketch ============================================================================================
+// 'Depth' rows of 'Width' counters. Every row has its own position for a value, derived from a single 'std::hash' call
+// by double hashing. The estimate is the minimum of the value's counters, it is never less than the real count. With
+// a total count of N, the estimate exceeds the real count by more than e * N / Width with probability at most
+// e^-Depth. The default size is 4 x 4096 counters, i.e. 64 KiB.
+//
+// Sketches with the same parameters and 'Hasher' can be merged by adding the counters, the compiler can vectorize it.
+
+template <class Type, class Hasher = std::hash<Type>, std::size_t Width = 4096, std::size_t Depth = 4>
+class CountMinSketch {
+	static_assert(StdHashable<Type> || !std::is_same_v<Hasher, std::hash<Type>>, "'Type' is not hashable.");
+	static_assert(IsPowerOf2(Width), "'Width' must be a power of 2.");
+	static_assert(Depth >= 1, "'Depth' must be positive.");
+
+public:
+	CountMinSketch() :
+		mCounters(Width * Depth, 0)
+	{
+	}
+
+	void Add(const Type& value, UInt32 count = 1) {
+		const UInt64 hash = GetHash(value);
+		for (std::size_t row = 0; row < Depth; row++)
+			mCounters[GetCounterIndex(hash, row)] += count;
+
+		mTotal += count;
+	}
+
+	UInt32 Estimate(const Type& value) const {
+		const UInt64 hash = GetHash(value);
+
+		UInt32 result = mCounters[GetCounterIndex(hash, 0)];
+		for (std::size_t row = 1; row < Depth; row++)
+			result = std::min(result, mCounters[GetCounterIndex(hash, row)]);
+
+		return result;
+	}
+
+	void Merge(const CountMinSketch& other) {
+		UInt32*       counters      = mCounters.data();
+		const UInt32* otherCounters = other.mCounters.data();
+
+		for (std::size_t i = 0; i < Width * Depth; i++)
+			counters[i] += otherCounters[i];
+
+		mTotal += other.mTotal;
+	}
+
+	UInt64 GetTotal() const {
+		return mTotal;
+	}
+
+	void Clear() {
+		std::ranges::fill(mCounters, UInt32(0));
+		mTotal = 0;
+	}
+
+private:
+	UInt64 GetHash(const Type& value) const {
+		return FMix64(static_cast<UInt64>(mHasher(value)));
+	}
+
+	static std::size_t GetCounterIndex(UInt64 hash, std::size_t row) {
+		const UInt32 h1 = static_cast<UInt32>(hash);
+		const UInt32 h2 = static_cast<UInt32>(hash >> 32) | 1;
+
+		return row * Width + ((h1 + row * h2) & (Width - 1));
+	}
+
+	std::vector<UInt32> mCounters;
+	UInt64              mTotal = 0;
+	Hasher              mHasher;
+};
+
+
+}	// namespace BF
@@ -0,0 +1,224 @@
+// A probabilistic set membership filter, which supports erasing. It stores a short fingerprint of every value.
+// 'MayContain()' never returns false for an inserted value, but it can return true for a value that was not inserted,
+// with a configurable probability.
+
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <span>
+#include <vector>
+#include "BF/Assert.hpp"
+#include "BF/Hash.hpp"
+
+
+namespace BF {
+
+
+// === class CuckooFilter ==============================================================================================
+// Buckets of four fingerprints. A value can be in two buckets: the first one comes from the high bits of the hash, the
+// fingerprint from the low bits, and the alternate bucket is the first one XOR the hash of the fingerprint. Thus both
+// bucket positions and the fingerprint come from a single 'std::hash' call, and a fingerprint can be moved to its
+// other bucket without knowing the value. The false positive rate is about 8 / 2^fingerprintBits, the number of
+// fingerprint bits is chosen from the requested rate.
+//
+// 'Insert()' fails (and returns false) if the filter is full. In that case the filter is unchanged. Only inserted
+// values should be erased, otherwise another value's fingerprint could be removed. The same value can be inserted a
+// few times, then it should be erased the same number of times.
+
+template <class Type, class Hasher = std::hash<Type>>
+class CuckooFilter {
+	static_assert(StdHashable<Type> || !std::is_same_v<Hasher, std::hash<Type>>, "'Type' is not hashable.");
+
+public:
+	CuckooFilter(std::size_t expectedCount, double falsePositiveRate) {
+		BF_ASSERT(falsePositiveRate > 0 && falsePositiveRate < 1);
+
+		const double bits = std::ceil(std::log2(2.0 * BucketSize / falsePositiveRate));
+		mFingerprintMask  = static_cast<Fingerprint>((UInt32(1) << std::clamp(static_cast<int>(bits), MinFingerprintBits, 16)) - 1);
+
+		const std::size_t minBucketCount = static_cast<std::size_t>(static_cast<double>(expectedCount) / (BucketSize * MaxLoad)) + 1;
+		mBuckets.resize(std::bit_ceil(minBucketCount));
+		BF_ASSERT(mBuckets.size() <= MaxBucketCount);
+	}
+
+	CuckooFilter(std::span<const std::byte> bytes, int fingerprintBits) :	// reads the result of 'GetBytes()'
+		mBuckets(bytes.size() / sizeof(Bucket)),
+		mFingerprintMask(static_cast<Fingerprint>((UInt32(1) << fingerprintBits) - 1))
+	{
+		BF_ASSERT(bytes.size() % sizeof(Bucket) == 0 && IsPowerOf2(mBuckets.size()) && mBuckets.size() <= MaxBucketCount);
+		BF_ASSERT(fingerprintBits >= MinFingerprintBits && fingerprintBits <= 16);
+
+		std::memcpy(mBuckets.data(), bytes.data(), bytes.size());
+
+		for (const Bucket& bucket : mBuckets)
+			mSize += static_cast<std::size_t>(std::ranges::count_if(bucket, [](Fingerprint slot) { return slot != 0; }));
+	}
+
+	bool Insert(const Type& value) {
+		return InsertHash(GetHash(value));
+	}
+
+	bool MayContain(const Type& value) const {
+		return MayContainHash(GetHash(value));
+	}
+
+	bool Erase(const Type& value) {
+		const UInt64      hash        = GetHash(value);
+		const Fingerprint fingerprint = GetFingerprint(hash);
+		const std::size_t index1      = GetIndex(hash);
+
+		return EraseFrom(index1, fingerprint) || EraseFrom(GetAlternateIndex(index1, fingerprint), fingerprint);
+	}
+
+	std::size_t InsertMany(std::span<const Type> values) {		// returns the number of successfully inserted values
+		std::size_t count = 0;
+		ForEachHash(values, [this, &count](std::size_t, UInt64 hash) { count += InsertHash(hash); });
+		return count;
+	}
+
+	void MayContainMany(std::span<const Type> values, std::span<bool> results) const {
+		BF_ASSERT(values.size() == results.size());
+		ForEachHash(values, [this, results](std::size_t i, UInt64 hash) { results[i] = MayContainHash(hash); });
+	}
+
+	std::size_t GetSize() const {
+		return mSize;
+	}
+
+	std::span<const std::byte> GetBytes() const {
+		return std::as_bytes(std::span(mBuckets));
+	}
+
+	int GetFingerprintBits() const {
+		return std::popcount(mFingerprintMask);
+	}
+
+private:
+	using Fingerprint = UInt16;									// 0 means empty
+	using Bucket      = std::array<Fingerprint, 4>;
+
+	constexpr static std::size_t BucketSize         = std::tuple_size_v<Bucket>;
+	constexpr static double      MaxLoad            = 0.9;
+	constexpr static int         MaxKicks           = 500;
+	constexpr static int         MinFingerprintBits = 8;				// fewer alternate buckets would limit the load
+	constexpr static std::size_t HashBlockSize      = 16;
+	constexpr static UInt64      MaxBucketCount     = UInt64(1) << 32;	// see 'GetIndex()'
+
+	UInt64 GetHash(const Type& value) const {
+		return FMix64(static_cast<UInt64>(mHasher(value)));
+	}
+
+	template <class Func>
+	void ForEachHash(std::span<const Type> values, Func func) const {
+		for (std::size_t i = 0; i < values.size(); i += HashBlockSize) {
+			const std::size_t count = std::min(HashBlockSize, values.size() - i);
+
+			UInt64 hashes[HashBlockSize];
+			for (std::size_t j = 0; j < count; j++)
+				hashes[j] = GetHash(values[i + j]);
+
+			for (std::size_t j = 0; j < count; j++)
+				func(i + j, hashes[j]);
+		}
+	}
+
+	std::size_t GetIndex(UInt64 hash) const {
+		return static_cast<std::size_t>(hash >> 32) & (mBuckets.size() - 1);
+	}
+
+	Fingerprint GetFingerprint(UInt64 hash) const {
+		const Fingerprint fingerprint = static_cast<Fingerprint>(hash) & mFingerprintMask;
+		return fingerprint != 0 ? fingerprint : 1;
+	}
+
+	std::size_t GetAlternateIndex(std::size_t index, Fingerprint fingerprint) const {	// its own inverse
+		return (index ^ static_cast<std::size_t>(FMix64(fingerprint))) & (mBuckets.size() - 1);
+	}
+
+	bool InsertInto(std::size_t index, Fingerprint fingerprint) {
+		for (Fingerprint& slot : mBuckets[index]) {
+			if (slot == 0) {
+				slot = fingerprint;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool EraseFrom(std::size_t index, Fingerprint fingerprint) {
+		for (Fingerprint& slot : mBuckets[index]) {
+			if (slot == fingerprint) {
+				slot = 0;
+				mSize--;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	static bool BucketContains(const Bucket& bucket, Fingerprint fingerprint) {
+		bool result = false;
+		for (const Fingerprint slot : bucket)					// no early exit, the loop can be vectorized
+			result |= (slot == fingerprint);
+
+		return result;
+	}
+
+	bool MayContainHash(UInt64 hash) const {
+		const Fingerprint fingerprint = GetFingerprint(hash);
+		const std::size_t index1      = GetIndex(hash);
+
+		return BucketContains(mBuckets[index1], fingerprint) || BucketContains(mBuckets[GetAlternateIndex(index1, fingerprint)], fingerprint);
+	}
+
+	bool InsertHash(UInt64 hash) {
+		Fingerprint       fingerprint = GetFingerprint(hash);
+		const std::size_t index1      = GetIndex(hash);
+		const std::size_t index2      = GetAlternateIndex(index1, fingerprint);
+
+		if (InsertInto(index1, fingerprint) || InsertInto(index2, fingerprint)) {
+			mSize++;
+			return true;
+		}
+
+		// Kicking out fingerprints to their alternate buckets. The path is recorded, so it can be undone on failure.
+		struct Kick {
+			std::size_t index;
+			std::size_t slot;
+		};
+
+		std::array<Kick, MaxKicks> kicks;
+		std::size_t                index = (hash & 1) ? index1 : index2;
+
+		for (int k = 0; k < MaxKicks; k++) {
+			const std::size_t slot = (fingerprint + k) % BucketSize;
+			std::swap(fingerprint, mBuckets[index][slot]);
+			kicks[k] = { index, slot };
+
+			index = GetAlternateIndex(index, fingerprint);
+			if (InsertInto(index, fingerprint)) {
+				mSize++;
+				return true;
+			}
+		}
+
+		for (int k = MaxKicks - 1; k >= 0; k--)
+			std::swap(fingerprint, mBuckets[kicks[k].index][kicks[k].slot]);
+
+		return false;
+	}
+
+	std::vector<Bucket> mBuckets;
+	Fingerprint         mFingerprintMask = 0;
+	std::size_t         mSize            = 0;
+	Hasher              mHasher;
+};
+
+
+}	// namespace BF
@@ -63,6 +63,15 @@ constexpr UChar MaxUChar = UINT8_MAX;
 #define BF_NOINLINE						[[msvc::noinline]]
 
 
+// === BF_FORCEINLINE ==================================================================================================
+
+#if defined(_MSC_VER)
+	#define BF_FORCEINLINE				[[msvc::forceinline]]
+#else
+	#define BF_FORCEINLINE				[[gnu::always_inline]] inline
+#endif
+
+
 // === BF_IMPLIES ======================================================================================================
 
 #define BF_IMPLIES						<=
@@ -0,0 +1,580 @@
+// Open addressing hash containers, which store the elements inline, in a single array. They use the same hashing
+// protocol as the Standard Library unordered containers, thus every type made hashable by 'BF/Hash.hpp' works.
+
+
+#pragma once
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include "BF/Assert.hpp"
+#include "BF/Hash.hpp"
+
+
+namespace BF {
+
+
+// === Implementation details ==========================================================================================
+
+namespace ImpFlatHash {
+
+
+// Every slot has a control byte. A full slot stores the low 7 bits of the hash ('H2') in it, so most key comparisons
+// of unrelated keys are avoided. The other hash bits ('H1') select the first probed position.
+constexpr Int8 Empty   = -128;		// 0b10000000
+constexpr Int8 Deleted = -2;		// 0b11111110
+
+
+// === class Group ===
+// Eight control bytes, which are examined at the same time, in a 64 bit integer (SIMD within a register). The masks
+// have the highest bit set for every matching byte.
+class Group {
+public:
+	constexpr static std::size_t Width = 8;
+
+	explicit Group(const Int8* ctrl) {
+		std::memcpy(&mCtrl, ctrl, Width);
+		if constexpr (std::endian::native == std::endian::big)
+			mCtrl = std::byteswap(mCtrl);
+	}
+
+	UInt64 Match(Int8 h2) const {						// may have false positives, but only for full slots
+		const UInt64 x = mCtrl ^ (Lsbs * static_cast<UInt8>(h2));
+		return (x - Lsbs) & ~x & Msbs;
+	}
+
+	UInt64 MaskEmpty() const {
+		return mCtrl & ~(mCtrl << 6) & Msbs;
+	}
+
+	UInt64 MaskEmptyOrDeleted() const {
+		return mCtrl & ~(mCtrl << 7) & Msbs;
+	}
+
+	static std::size_t GetLowestIndex(UInt64 mask) {
+		return std::countr_zero(mask) / 8;
+	}
+
+	static std::size_t CountLeadingUnset(UInt64 mask) {
+		return std::countl_zero(mask) / 8;
+	}
+
+	static std::size_t CountTrailingUnset(UInt64 mask) {
+		return std::countr_zero(mask) / 8;
+	}
+
+private:
+	constexpr static UInt64 Lsbs = 0x0101010101010101;
+	constexpr static UInt64 Msbs = 0x8080808080808080;
+
+	UInt64 mCtrl;
+};
+
+
+template <class Key>
+struct SetPolicy {
+	using KeyType   = Key;
+	using ValueType = Key;
+
+	constexpr static bool IsValueMutable = false;
+
+	static const Key& GetKey(const ValueType& value) { return value; }
+};
+
+
+template <class Key, class Value>
+struct MapPolicy {
+	using KeyType   = Key;
+	using ValueType = std::pair<const Key, Value>;
+
+	constexpr static bool IsValueMutable = true;
+
+	static const Key& GetKey(const ValueType& value) { return value.first; }
+};
+
+
+// Heterogeneous lookup keys are deduced only if 'Transparent' is true. A nested alias template is needed for that,
+// 'std::conditional_t' would make them non-deduced.
+template <bool Transparent>
+struct KeyArgSelector {
+	template <class LookupKey, class Key>
+	using Type = LookupKey;
+};
+
+
+template <>
+struct KeyArgSelector<false> {
+	template <class LookupKey, class Key>
+	using Type = Key;
+};
+
+
+// === class FlatHashTable ===
+// The capacity is zero or a power of two, at least 'Group::Width'. After the control bytes of the slots, the first
+// 'Group::Width - 1' control bytes are repeated, so a group can be loaded at any position without wrapping around.
+// Groups are probed quadratically, which visits every slot. The maximum load factor is 7/8.
+//
+// Erasing a slot makes it empty, if no probe sequence could have passed through it, i.e. there was never a full group
+// around it. Otherwise it becomes deleted (a tombstone). When the table runs out of empty slots and most of the
+// non-full slots are tombstones, it is rehashed in place instead of growing.
+template <class Policy, class Hasher, class KeyEqual>
+class FlatHashTable {
+	constexpr static bool IsTransparent = requires {
+		typename Hasher::is_transparent;
+		typename KeyEqual::is_transparent;
+	};
+
+public:
+	using key_type        = typename Policy::KeyType;
+	using value_type      = typename Policy::ValueType;
+	using size_type       = std::size_t;
+	using difference_type = std::ptrdiff_t;
+	using hasher          = Hasher;
+	using key_equal       = KeyEqual;
+	using reference       = value_type&;
+	using const_reference = const value_type&;
+
+protected:
+	// Heterogeneous lookup if both 'Hasher' and 'KeyEqual' are transparent, e.g. 'BF::LookupViewOf' views.
+	template <class LookupKey>
+	using KeyArg = typename KeyArgSelector<IsTransparent>::template Type<LookupKey, key_type>;
+
+public:
+	template <bool IsConst>
+	class Iterator {
+		friend class FlatHashTable;
+
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type        = typename Policy::ValueType;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+		using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+		Iterator() = default;
+
+		template <bool OtherIsConst>								// not a copy constructor, that would be suppressed
+		requires (IsConst && !OtherIsConst)
+		Iterator(const Iterator<OtherIsConst>& other) :
+			mCtrl(other.mCtrl),
+			mCtrlEnd(other.mCtrlEnd),
+			mSlot(other.mSlot)
+		{
+		}
+
+		reference operator*() const  { return *mSlot; }
+		pointer   operator->() const { return mSlot; }
+
+		Iterator& operator++() {
+			++mCtrl;
+			++mSlot;
+			SkipNonFull();
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator result = *this;
+			++*this;
+			return result;
+		}
+
+		friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+			return lhs.mSlot == rhs.mSlot;
+		}
+
+	private:
+		template <bool>
+		friend class Iterator;
+
+		Iterator(const Int8* ctrl, const Int8* ctrlEnd, pointer slot) :
+			mCtrl(ctrl),
+			mCtrlEnd(ctrlEnd),
+			mSlot(slot)
+		{
+		}
+
+		void SkipNonFull() {
+			while (mCtrl != mCtrlEnd && *mCtrl < 0) {
+				++mCtrl;
+				++mSlot;
+			}
+		}
+
+		const Int8* mCtrl    = nullptr;
+		const Int8* mCtrlEnd = nullptr;
+		pointer     mSlot    = nullptr;
+	};
+
+	using iterator       = Iterator<!Policy::IsValueMutable>;		// the elements of a set are immutable
+	using const_iterator = Iterator<true>;
+
+	FlatHashTable() = default;
+
+	explicit FlatHashTable(size_type capacity, const Hasher& hasher = Hasher(), const KeyEqual& keyEqual = KeyEqual()) :
+		mHasher(hasher),
+		mKeyEqual(keyEqual)
+	{
+		Reserve(capacity);
+	}
+
+	FlatHashTable(std::initializer_list<value_type> values) {
+		Reserve(values.size());
+		for (const value_type& value : values)
+			Insert(value);
+	}
+
+	FlatHashTable(const FlatHashTable& other) :
+		mHasher(other.mHasher),
+		mKeyEqual(other.mKeyEqual)
+	{
+		Reserve(other.mSize);
+		for (const value_type& value : other) {					// the keys are unique, no lookup is needed
+			const UInt64      hash  = GetHash(Policy::GetKey(value));
+			const std::size_t index = PrepareInsert(hash);
+			std::construct_at(mSlots + index, value);
+			CommitInsert(index, hash);
+		}
+	}
+
+	FlatHashTable(FlatHashTable&& other) noexcept :
+		mCtrl(std::move(other.mCtrl)),
+		mSlots(std::exchange(other.mSlots, nullptr)),
+		mCapacity(std::exchange(other.mCapacity, 0)),
+		mSize(std::exchange(other.mSize, 0)),
+		mGrowthLeft(std::exchange(other.mGrowthLeft, 0)),
+		mHasher(other.mHasher),
+		mKeyEqual(other.mKeyEqual)
+	{
+	}
+
+	FlatHashTable& operator=(FlatHashTable other) noexcept {
+		Swap(other);
+		return *this;
+	}
+
+	~FlatHashTable() {
+		DestroyAll();
+		std::allocator<value_type>().deallocate(mSlots, mCapacity);
+	}
+
+	void Swap(FlatHashTable& other) noexcept {
+		using std::swap;
+		swap(mCtrl,       other.mCtrl);
+		swap(mSlots,      other.mSlots);
+		swap(mCapacity,   other.mCapacity);
+		swap(mSize,       other.mSize);
+		swap(mGrowthLeft, other.mGrowthLeft);
+		swap(mHasher,     other.mHasher);
+		swap(mKeyEqual,   other.mKeyEqual);
+	}
+
+	iterator       begin()       { return MakeBeginIterator<iterator>(); }
+	const_iterator begin() const { return MakeBeginIterator<const_iterator>(); }
+	iterator       end()         { return MakeIterator<iterator>(mCapacity); }
+	const_iterator end() const   { return MakeIterator<const_iterator>(mCapacity); }
+
+	size_type GetSize() const     { return mSize; }
+	bool      IsEmpty() const     { return mSize == 0; }
+	size_type GetCapacity() const { return mCapacity; }
+
+	void Clear() {
+		DestroyAll();
+		if (mCapacity > 0)
+			std::memset(mCtrl.get(), Empty, GetCtrlSize(mCapacity));
+
+		mSize       = 0;
+		mGrowthLeft = GetMaxLoad(mCapacity);
+	}
+
+	void Reserve(size_type size) {								// 'size' elements can be inserted without rehashing
+		if (size == 0)
+			return;
+
+		std::size_t capacity = Group::Width;
+		while (GetMaxLoad(capacity) < size)
+			capacity *= 2;
+
+		if (capacity > mCapacity)
+			Rehash(capacity);
+	}
+
+	template <class LookupKey = key_type>
+	iterator Find(const KeyArg<LookupKey>& key) {
+		return MakeIterator<iterator>(FindIndex(key, GetHash(key)));
+	}
+
+	template <class LookupKey = key_type>
+	const_iterator Find(const KeyArg<LookupKey>& key) const {
+		return MakeIterator<const_iterator>(FindIndex(key, GetHash(key)));
+	}
+
+	template <class LookupKey = key_type>
+	bool Contains(const KeyArg<LookupKey>& key) const {
+		return FindIndex(key, GetHash(key)) != mCapacity;
+	}
+
+	std::pair<iterator, bool> Insert(const value_type& value) {
+		return EmplaceUnique(Policy::GetKey(value), value);
+	}
+
+	std::pair<iterator, bool> Insert(value_type&& value) {
+		return EmplaceUnique(Policy::GetKey(value), std::move(value));
+	}
+
+	template <class LookupKey = key_type>
+	size_type Erase(const KeyArg<LookupKey>& key) {
+		const std::size_t index = FindIndex(key, GetHash(key));
+		if (index == mCapacity)
+			return 0;
+
+		EraseIndex(index);
+		return 1;
+	}
+
+	void Erase(const_iterator it) {								// other iterators remain valid
+		BF_ASSERT(it != end());
+		EraseIndex(static_cast<std::size_t>(it.mSlot - mSlots));
+	}
+
+	// Otherwise a transparent table would deduce 'LookupKey = iterator' above, a better match than the conversion.
+	void Erase(iterator it) requires (!std::is_same_v<iterator, const_iterator>) {
+		Erase(const_iterator(it));
+	}
+
+protected:
+	// 'key' is used for the lookup, 'constructionArgs' for constructing the element if the key is not found.
+	template <class LookupKey, class... Args>
+	std::pair<iterator, bool> EmplaceUnique(const LookupKey& key, Args&&... constructionArgs) {
+		const UInt64 hash = GetHash(key);
+		if (const std::size_t index = FindIndex(key, hash); index != mCapacity)
+			return { MakeIterator<iterator>(index), false };
+
+		const std::size_t index = PrepareInsert(hash);
+		std::construct_at(mSlots + index, BF_FWD(constructionArgs)...);
+		CommitInsert(index, hash);
+
+		return { MakeIterator<iterator>(index), true };
+	}
+
+private:
+	constexpr static UInt64 Salt = 0x9e3779b97f4a7c15;
+
+	static std::size_t GetMaxLoad(std::size_t capacity) { return capacity - capacity / 8; }
+	static std::size_t GetCtrlSize(std::size_t capacity) { return capacity + Group::Width - 1; }
+
+	static std::size_t GetH1(UInt64 hash) { return static_cast<std::size_t>(hash >> 7); }
+	static Int8        GetH2(UInt64 hash) { return static_cast<Int8>(hash & 0x7F); }
+
+	template <class LookupKey>
+	UInt64 GetHash(const LookupKey& key) const {				// 'std::hash' of integers is often the identity
+		return UMul128Fold(static_cast<UInt64>(mHasher(key)), Salt);
+	}
+
+	template <class It>
+	It MakeIterator(std::size_t index) const {
+		return It(mCtrl.get() + index, mCtrl.get() + mCapacity, mSlots + index);
+	}
+
+	template <class It>
+	It MakeBeginIterator() const {
+		It it = MakeIterator<It>(0);
+		it.SkipNonFull();
+		return it;
+	}
+
+	template <class LookupKey>
+	std::size_t FindIndex(const LookupKey& key, UInt64 hash) const {		// returns 'mCapacity' if not found
+		if (mCapacity == 0)
+			return mCapacity;
+
+		const std::size_t mask = mCapacity - 1;
+		const Int8        h2   = GetH2(hash);
+
+		std::size_t pos  = GetH1(hash) & mask;
+		std::size_t step = 0;
+		while (true) {
+			const Group group(mCtrl.get() + pos);
+			for (UInt64 match = group.Match(h2); match != 0; match &= match - 1) {
+				const std::size_t index = (pos + Group::GetLowestIndex(match)) & mask;
+				if (mKeyEqual(Policy::GetKey(mSlots[index]), key))
+					return index;
+			}
+
+			if (group.MaskEmpty() != 0)
+				return mCapacity;
+
+			step += Group::Width;
+			pos   = (pos + step) & mask;
+		}
+	}
+
+	std::size_t FindFirstNonFull(UInt64 hash) const {
+		const std::size_t mask = mCapacity - 1;
+
+		std::size_t pos  = GetH1(hash) & mask;
+		std::size_t step = 0;
+		while (true) {
+			if (const UInt64 mask2 = Group(mCtrl.get() + pos).MaskEmptyOrDeleted(); mask2 != 0)
+				return (pos + Group::GetLowestIndex(mask2)) & mask;
+
+			step += Group::Width;
+			pos   = (pos + step) & mask;
+		}
+	}
+
+	std::size_t PrepareInsert(UInt64 hash) {					// may rehash, the element is not constructed yet
+		if (mCapacity == 0) {
+			Rehash(Group::Width);
+			return FindFirstNonFull(hash);
+		}
+
+		std::size_t index = FindFirstNonFull(hash);
+		if (mGrowthLeft == 0 && mCtrl[index] != Deleted) {
+			RehashForInsert();
+			index = FindFirstNonFull(hash);
+		}
+
+		return index;
+	}
+
+	void CommitInsert(std::size_t index, UInt64 hash) {
+		mGrowthLeft -= (mCtrl[index] == Empty);
+		SetCtrl(index, GetH2(hash));
+		mSize++;
+	}
+
+	void RehashForInsert() {
+		if (mCapacity > Group::Width && mSize <= GetMaxLoad(mCapacity) / 2)
+			Rehash(mCapacity);									// mostly tombstones, drop them
+		else
+			Rehash(mCapacity * 2);
+	}
+
+	void Rehash(std::size_t capacity) {
+		BF_ASSERT(IsPowerOf2(capacity) && capacity >= Group::Width && GetMaxLoad(capacity) >= mSize);
+
+		std::unique_ptr<Int8[]> oldCtrl     = std::exchange(mCtrl, std::make_unique_for_overwrite<Int8[]>(GetCtrlSize(capacity)));
+		value_type*             oldSlots    = std::exchange(mSlots, std::allocator<value_type>().allocate(capacity));
+		const std::size_t       oldCapacity = std::exchange(mCapacity, capacity);
+
+		std::memset(mCtrl.get(), Empty, GetCtrlSize(capacity));
+
+		for (std::size_t i = 0; i < oldCapacity; i++) {
+			if (oldCtrl[i] < 0)
+				continue;
+
+			const UInt64      hash  = GetHash(Policy::GetKey(oldSlots[i]));
+			const std::size_t index = FindFirstNonFull(hash);
+			std::construct_at(mSlots + index, std::move(oldSlots[i]));
+			std::destroy_at(oldSlots + i);
+			SetCtrl(index, GetH2(hash));
+		}
+
+		std::allocator<value_type>().deallocate(oldSlots, oldCapacity);
+		mGrowthLeft = GetMaxLoad(capacity) - mSize;
+	}
+
+	void EraseIndex(std::size_t index) {
+		std::destroy_at(mSlots + index);
+
+		const std::size_t mask        = mCapacity - 1;
+		const UInt64      emptyBefore = Group(mCtrl.get() + ((index - Group::Width) & mask)).MaskEmpty();
+		const UInt64      emptyAfter  = Group(mCtrl.get() + index).MaskEmpty();
+
+		const bool wasNeverFull = emptyBefore != 0 && emptyAfter != 0 &&
+			Group::CountLeadingUnset(emptyBefore) + Group::CountTrailingUnset(emptyAfter) < Group::Width;
+
+		SetCtrl(index, wasNeverFull ? Empty : Deleted);
+		mGrowthLeft += wasNeverFull;
+		mSize--;
+	}
+
+	void SetCtrl(std::size_t index, Int8 ctrl) {
+		mCtrl[index] = ctrl;
+		if (index < Group::Width - 1)
+			mCtrl[mCapacity + index] = ctrl;					// the repeated bytes
+	}
+
+	void DestroyAll() {
+		if constexpr (!std::is_trivially_destructible_v<value_type>) {
+			for (std::size_t i = 0; i < mCapacity; i++) {
+				if (mCtrl[i] >= 0)
+					std::destroy_at(mSlots + i);
+			}
+		}
+	}
+
+	std::unique_ptr<Int8[]> mCtrl;
+	value_type*             mSlots      = nullptr;
+	std::size_t             mCapacity   = 0;
+	std::size_t             mSize       = 0;
+	std::size_t             mGrowthLeft = 0;
+	Hasher                  mHasher;
+	KeyEqual                mKeyEqual;
+};
+
+
+}	// namespace ImpFlatHash
+
+
+// === class FlatHashSet ===============================================================================================
+
+template <class Key, class Hasher = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class FlatHashSet : public ImpFlatHash::FlatHashTable<ImpFlatHash::SetPolicy<Key>, Hasher, KeyEqual> {
+	using Base = ImpFlatHash::FlatHashTable<ImpFlatHash::SetPolicy<Key>, Hasher, KeyEqual>;
+
+public:
+	using Base::Base;
+};
+
+
+// === class FlatHashMap ===============================================================================================
+
+template <class Key, class Value, class Hasher = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class FlatHashMap : public ImpFlatHash::FlatHashTable<ImpFlatHash::MapPolicy<Key, Value>, Hasher, KeyEqual> {
+	using Base = ImpFlatHash::FlatHashTable<ImpFlatHash::MapPolicy<Key, Value>, Hasher, KeyEqual>;
+
+public:
+	using mapped_type = Value;
+	using typename Base::iterator;
+
+	using Base::Base;
+
+	template <class... Args>
+	std::pair<iterator, bool> TryEmplace(const Key& key, Args&&... args) {
+		return this->EmplaceUnique(key, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(BF_FWD(args)...));
+	}
+
+	template <class... Args>
+	std::pair<iterator, bool> TryEmplace(Key&& key, Args&&... args) {
+		return this->EmplaceUnique(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::forward_as_tuple(BF_FWD(args)...));
+	}
+
+	template <class Par>
+	std::pair<iterator, bool> InsertOrAssign(const Key& key, Par&& value) {
+		auto result = TryEmplace(key, BF_FWD(value));
+		if (!result.second)
+			result.first->second = BF_FWD(value);
+
+		return result;
+	}
+
+	template <class Par>
+	std::pair<iterator, bool> InsertOrAssign(Key&& key, Par&& value) {
+		auto result = TryEmplace(std::move(key), BF_FWD(value));
+		if (!result.second)
+			result.first->second = BF_FWD(value);
+
+		return result;
+	}
+
+	Value& operator[](const Key& key) { return TryEmplace(key).first->second; }
+	Value& operator[](Key&& key)      { return TryEmplace(std::move(key)).first->second; }
+};
+
+
+}	// namespace BF
@@ -0,0 +1,50 @@
+#include "BF/Hash.hpp"
+
+#include <chrono>
+#include <random>
+
+#if defined(IMP_BF_X64) && defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+
+
+namespace BF {
+
+
+UInt64 ImpHash::MakeProcessHashSeed()
+{
+	std::random_device device;										// it can be deterministic on some platforms
+	const UInt64       random = (UInt64(device()) << 32) ^ device();
+	const UInt64       time   = static_cast<UInt64>(std::chrono::steady_clock::now().time_since_epoch().count());
+	const UInt64       aslr   = reinterpret_cast<std::uintptr_t>(&device);
+
+	return FMix64(random ^ FMix64(time ^ FMix64(aslr)));
+}
+
+
+#if defined(IMP_BF_X64)
+
+bool ImpHash::DetectAVX2()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+
+	__cpuid(info, 1);
+	const bool avx       = (info[2] & (1 << 28)) != 0;
+	const bool osSaveYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;	// and the OS saves YMM
+
+	__cpuidex(info, 7, 0);
+	return avx && osSaveYmm && (info[1] & (1 << 5)) != 0;
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");							// checks the OS support too
+#endif
+}
+
+#endif
+
+
+}	// namespace BF
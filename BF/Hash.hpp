@@ -3,6 +3,9 @@
 
 #pragma once
 #include <concepts>
+#include "BF/BasicMath.hpp"
+#include "BF/HashBytes.hpp"
+#include "BF/RawMemory.hpp"
 #include "BF/TypeTraits.hpp"
 
 
@@ -17,12 +20,24 @@ concept StdHashable = requires (const Type value) {
 };
 
 
-// === Implementation details ==========================================================================================
+// === Hash combinators ================================================================================================
+// A hash combinator folds a sequence of 'std::size_t' hash values into one. The combinator of 'BF::Hash' is
+// 'FNV1aCombinator'. Other ones can be selected with 'BF::BasicHash<Combinator>'.
+//   - 'Add(hash)' absorbs the next hash value.
+//   - 'Get()' returns the combined hash value.
+//   - 'Single(hash)' returns the same, as adding 'hash' to a default constructed combinator, and then calling 'Get()'.
+//     Except for 'FNV1aCombinator', where it returns 'hash' unchanged, so that wrapping a single member is free.
 
-namespace ImpHash {
+template <class Type>
+concept HashCombinatorPolicy = std::semiregular<Type> && requires (Type combinator, const Type cCombinator, std::size_t hash) {
+	combinator.Add(hash);
+	{ cCombinator.Get() }  -> std::same_as<std::size_t>;
+	{ Type::Single(hash) } -> std::same_as<std::size_t>;
+};
 
 
 // https://en.wikipedia.org/wiki/Fowler-Noll-Vo_hash_function#FNV-1a_hash
+// One xor and one multiplication per hash value, but every step depends on the previous one.
 class FNV1aCombinator {
 public:
 	constexpr FNV1aCombinator() {
@@ -38,6 +53,10 @@ public:
 		return mHash;
 	}
 
+	constexpr static std::size_t Single(std::size_t hash) {
+		return hash;
+	}
+
 private:
 	static_assert(sizeof(std::size_t) == 8, "This algorithm is for 64 bits.");
 
@@ -48,21 +67,211 @@ private:
 };
 
 
-class HashCombinator : private FNV1aCombinator {
+namespace ImpHash {
+
+// 'a ^ b' plus their folded 128 bit product. Unlike a bare multiplication, a zero operand doesn't erase the other one,
+// so a chosen value can't reset the state, and everything absorbed before it.
+constexpr UInt64 MixNonAbsorbing(UInt64 a, UInt64 b)
+{
+	return a ^ b ^ UMul128Fold(a, b);
+}
+
+}	// namespace ImpHash
+
+
+// https://github.com/wangyi-fudan/wyhash
+// Absorbs the hash values in pairs, with one 64 x 64 -> 128 bit multiplication per pair. Thus the dependency chain is
+// half as long as FNV-1a's, and the result is much better mixed. The state enters both operands of every
+// multiplication, so the hash values before a pair can't be cancelled by choosing the pair. 'BF::StableHash' has its
+// own frozen copy, so this one can be tuned.
+class WideMulCombinator {
+public:
+	constexpr void Add(std::size_t newHash) {
+		if (mCount % 2 == 0)
+			mPending = newHash;
+		else
+			mHash = ImpHash::MixNonAbsorbing(mPending ^ mHash ^ Secret1, newHash ^ mHash ^ Secret2);
+
+		mCount++;
+	}
+
+	constexpr std::size_t Get() const {
+		UInt64 hash = mHash;
+		if (mCount % 2 != 0)
+			hash = ImpHash::MixNonAbsorbing(mPending ^ mHash ^ Secret1, mHash ^ Secret3);
+
+		return ImpHash::MixNonAbsorbing(hash ^ Secret3, mCount ^ Secret0);
+	}
+
+	constexpr static std::size_t Single(std::size_t hash) {
+		WideMulCombinator combinator;
+		combinator.Add(hash);
+		return combinator.Get();
+	}
+
+private:
+	static_assert(sizeof(std::size_t) == 8, "This algorithm is for 64 bits.");
+
+	constexpr static UInt64 Secret0 = 0xa0761d6478bd642f;
+	constexpr static UInt64 Secret1 = 0xe7037ed1a0b428db;
+	constexpr static UInt64 Secret2 = 0x8ebc6af09c88c6e3;
+	constexpr static UInt64 Secret3 = 0x589965cc75374cc3;
+
+	UInt64 mHash    = Secret0;
+	UInt64 mPending = 0;
+	UInt64 mCount   = 0;
+};
+
+
+// Distributes the hash values among four independent lanes in a round-robin fashion, so four multiplications can be
+// in flight at the same time. The lanes are merged with 128 bit multiplications in 'Get()'.
+class MultiLaneCombinator {
+public:
+	constexpr void Add(std::size_t newHash) {
+		UInt64& lane = mLanes[mCount % LaneCount];
+		lane = (lane ^ newHash) * LanePrime;
+		mCount++;
+	}
+
+	constexpr std::size_t Get() const {
+		const UInt64 hash01 = ImpHash::MixNonAbsorbing(mLanes[0] ^ Secret0, mLanes[1] ^ Secret1);
+		const UInt64 hash23 = ImpHash::MixNonAbsorbing(mLanes[2] ^ Secret2, mLanes[3] ^ Secret3);
+		return ImpHash::MixNonAbsorbing(hash01 ^ mCount, hash23 ^ Secret0);
+	}
+
+	constexpr static std::size_t Single(std::size_t hash) {
+		MultiLaneCombinator combinator;
+		combinator.Add(hash);
+		return combinator.Get();
+	}
+
+private:
+	static_assert(sizeof(std::size_t) == 8, "This algorithm is for 64 bits.");
+
+	constexpr static UInt8  LaneCount = 4;
+	constexpr static UInt64 LanePrime = 0x9e3779b97f4a7c15;
+	constexpr static UInt64 Secret0   = 0xa0761d6478bd642f;
+	constexpr static UInt64 Secret1   = 0xe7037ed1a0b428db;
+	constexpr static UInt64 Secret2   = 0x8ebc6af09c88c6e3;
+	constexpr static UInt64 Secret3   = 0x589965cc75374cc3;
+
+	UInt64 mLanes[LaneCount] = { Secret3, Secret2, Secret1, Secret0 };
+	UInt64 mCount            = 0;
+};
+
+
+// === FMix64() ========================================================================================================
+// MurmurHash3's 64 bit finalizer. A bijection, in which every input bit affects every output bit.
+// https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
+
+constexpr UInt64 FMix64(UInt64 hash)
+{
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccd;
+	hash ^= hash >> 33;
+	hash *= 0xc4ceb9fe1a85ec53;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+
+// === class Avalanche =================================================================================================
+// Applies FMix64() to the result of 'Combinator'. Use it when the low bits of the hash value are used directly, e.g.
+// in power-of-two sized bucket tables. Without it, 'BF::Hash(someInt)' is the identity with some Standard Libraries,
+// and FNV-1a's low output bits depend only on the low bits of its input.
+
+template <HashCombinatorPolicy Combinator = FNV1aCombinator>
+class Avalanche : private Combinator {
+public:
+	constexpr void Add(std::size_t newHash) {
+		Combinator::Add(newHash);
+	}
+
+	constexpr std::size_t Get() const {
+		return FMix64(Combinator::Get());
+	}
+
+	constexpr static std::size_t Single(std::size_t hash) {
+		return FMix64(Combinator::Single(hash));
+	}
+};
+
+
+// === GetProcessHashSeed() ============================================================================================
+// A random value, chosen at the first call, and the same for the rest of the process. Different in every run.
+
+namespace ImpHash {
+UInt64 MakeProcessHashSeed();
+}
+
+
+inline UInt64 GetProcessHashSeed()
+{
+	static const UInt64 seed = ImpHash::MakeProcessHashSeed();
+	return seed;
+}
+
+
+// === class Seeded ====================================================================================================
+// Absorbs 'BF::GetProcessHashSeed()' before the hash values, so the result is different in every run. 'Single()' is
+// seeded too. The default is 'WideMulCombinator', whose state, and so the seed, enters both operands of every
+// multiplication, and a zero product doesn't erase it. Thus an attacker, who doesn't know the seed, can't choose
+// members which cancel it. FNV-1a's steps are invertible, so a seed only absorbed first doesn't stop colliding pairs of
+// members (e.g. the ones which collide with 'BF::Hash'). Keys whose members' 'std::hash' values are equal still
+// collide. Not constexpr, and the values must not be persisted.
+
+template <HashCombinatorPolicy Combinator = WideMulCombinator>
+class Seeded : private Combinator {
+public:
+	Seeded() {
+		Combinator::Add(GetProcessHashSeed());
+	}
+
+	constexpr void Add(std::size_t newHash) {
+		Combinator::Add(newHash);
+	}
+
+	constexpr std::size_t Get() const {
+		return Combinator::Get();
+	}
+
+	static std::size_t Single(std::size_t hash) {
+		Seeded combinator;
+		combinator.Add(hash);
+		return combinator.Get();
+	}
+};
+
+
+// === Implementation details ==========================================================================================
+
+namespace ImpHash {
+
+
+template <HashCombinatorPolicy Combinator = FNV1aCombinator>
+class HashCombinator : private Combinator {
 public:
 	constexpr HashCombinator() = default;
 
+	constexpr explicit HashCombinator(UInt64 seed) {		// the seed is absorbed before the values
+		Combinator::Add(seed);
+	}
+
 	constexpr void Add(const auto&... values) {
-		( ..., FNV1aCombinator::Add(GetHash(values)) );
+		( ..., Combinator::Add(GetHash(values)) );
+	}
+
+	constexpr void AddHash(std::size_t hash) {				// 'hash' is already a hash value, it won't be hashed again
+		Combinator::Add(hash);
 	}
 
 	constexpr std::size_t Get() const {
-		return FNV1aCombinator::Get();
+		return Combinator::Get();
 	}
 
 	constexpr static std::size_t Combine(const auto&... values) {
 		if constexpr (sizeof...(values) == 1) {
-			return GetHash(values...);
+			return Combinator::Single(GetHash(values...));
 		} else {
 			HashCombinator hc;
 			hc.Add(values...);
@@ -86,25 +295,49 @@ private:
 }	// namespace ImpHash
 
 
-// === class Hash ======================================================================================================
+// === class BasicHash, Hash ===========================================================================================
+
+template <HashCombinatorPolicy Combinator>
+class BasicHashState;
+
 
-class Hash final {
+template <HashCombinatorPolicy Combinator>
+class BasicHash final {
 public:
-	constexpr Hash(const auto&... values) :
-		mValue(ImpHash::HashCombinator::Combine(values...))
+	constexpr BasicHash(const auto&... values) :
+		mValue(ImpHash::HashCombinator<Combinator>::Combine(values...))
 	{
 	}
 
+	// 'value' is the 'std::hash' value of an earlier 'BasicHash' (e.g. precomputed or cached). It is not hashed again.
+	constexpr static BasicHash FromValue(std::size_t value) {
+		return BasicHash(FromValueSelector(), value);
+	}
+
 private:
 	template <class Type>
 	friend struct std::hash;
 
+	friend class BasicHashState<Combinator>;
+
+	struct FromValueSelector { explicit FromValueSelector() = default; };
+
+	constexpr BasicHash(FromValueSelector, std::size_t value) :		// 'value' is already the final hash value
+		mValue(value)
+	{
+	}
+
 	constexpr operator std::size_t() const { return mValue; }		// for usage inside 'std::hash' specializations
 
 	const std::size_t mValue;
 };
 
 
+using Hash          = BasicHash<FNV1aCombinator>;
+using AvalancheHash = BasicHash<Avalanche<FNV1aCombinator>>;
+using SeededHash    = BasicHash<Seeded<WideMulCombinator>>;
+
+
 // === Implementation details ==========================================================================================
 
 namespace ImpHash {
@@ -140,11 +373,18 @@ concept GetHashFunctionIsConst = requires (const Type value) { BF_GetHash(value)
 
 
 template <class Type>
-concept GetHashMethodReturnsHash   = requires (const Type value) { { value.BF_GetHash() } -> std::same_as<Hash>; };
+constexpr bool IsBasicHash = false;
+
+template <class Combinator>
+constexpr bool IsBasicHash<BasicHash<Combinator>> = true;
+
+
+template <class Type>
+concept GetHashMethodReturnsHash   = requires (const Type value) { requires IsBasicHash<decltype(value.BF_GetHash())>; };
 
 
 template <class Type>
-concept GetHashFunctionReturnsHash = requires (const Type value) { { BF_GetHash(value) } -> std::same_as<Hash>; };
+concept GetHashFunctionReturnsHash = requires (const Type value) { requires IsBasicHash<decltype(BF_GetHash(value))>; };
 
 
 }	// namespace ImpHash
@@ -156,13 +396,34 @@ template <class Type>
 concept HasGetHash = ImpHash::HasGetHashMethod<Type> || ImpHash::HasGetHashFunction<Type>;
 
 
+// === concept HashesAsBytes ===========================================================================================
+// Opt-in with 'constexpr static bool BF_HashAsBytes = true;' in a trivially copyable type with unique object
+// representations. Its 'std::hash' will hash the bytes of the whole object in one pass, instead of hashing the members
+// one by one, and combining their hash values.
+
+template <class Type>
+concept HashesAsBytes = requires { { Type::BF_HashAsBytes } -> std::same_as<const bool&>; } && Type::BF_HashAsBytes;
+
+
+// === concept LookupViewOf ============================================================================================
+// A lookup view of 'Owner' declares 'using BF_HashesAs = Owner;'. This is a promise, that it hashes identically to the
+// 'Owner' objects it compares equal to. The 'std::hash' specialization of 'Owner' is transparent, so such a view can
+// be used for heterogeneous lookup (with 'std::equal_to<>'), without constructing a temporary 'Owner'.
+
+template <class View, class Owner>
+concept LookupViewOf = std::same_as<typename View::BF_HashesAs, Owner> && StdHashable<View>;
+
+
 }	// namespace BF
 
 
-// === std::hash specialization ========================================================================================
+// === std::hash specializations =======================================================================================
 
-template <BF::HasGetHash Type>
+template <class Type>
+requires BF::HasGetHash<Type> || BF::HashesAsBytes<Type>
 struct std::hash<Type> {
+	constexpr static bool HashAsBytes         = BF::HashesAsBytes<Type>;
+
 	constexpr static bool HasMethod           = BF::ImpHash::HasGetHashMethod<Type>;
 	constexpr static bool MethodIsConst       = BF::ImpHash::GetHashMethodIsConst<Type>;
 	constexpr static bool MethodReturnsHash   = BF::ImpHash::GetHashMethodReturnsHash<Type>;
@@ -173,17 +434,38 @@ struct std::hash<Type> {
 
 	static_assert(BF::IsDecayed<Type>, "'Type' must be decayed.");
 	static_assert(!HasMethod || !HasFunction, "Ambiguous hashing: 'Type' has both a 'value.BF_GetHash()' method and a 'BF_GetHash(value)' function.");
+	static_assert(!HashAsBytes || !(HasMethod || HasFunction), "Ambiguous hashing: 'Type' has both 'BF_HashAsBytes' and 'BF_GetHash()'.");
 
 	static_assert(HasMethod       BF_IMPLIES MethodIsConst,       "BF_GetHash() method should be const.");
 	static_assert(MethodIsConst   BF_IMPLIES MethodReturnsHash,   "BF_GetHash() method should return BF::Hash.");
 	static_assert(HasFunction     BF_IMPLIES FunctionIsConst,     "BF_GetHash() function's parameter should be const.");
 	static_assert(FunctionIsConst BF_IMPLIES FunctionReturnsHash, "BF_GetHash() function should return BF::Hash.");
 
+	using is_transparent = void;										// see 'BF::LookupViewOf'
+
+	[[nodiscard]]
+	constexpr static std::size_t operator()(const BF::LookupViewOf<Type> auto& view) {
+		return std::hash<std::remove_cvref_t<decltype(view)>>()(view);
+	}
+
 	[[nodiscard]]
 	constexpr static std::size_t operator()(const Type& value) {
-		if constexpr (HasMethod)
+		if constexpr (HashAsBytes && sizeof(Type) < BF::ImpHash::StripeHasher::MinSize)	// 'BF::HashBytes()', inlined
+			return BF::ImpHash::BytesHasher::HashInline(BF::AsByteArray(value), sizeof(Type));
+		else if constexpr (HashAsBytes)
+			return BF::HashBytes(BF::AsByteArray(value));
+		else if constexpr (HasMethod)
 			return value.BF_GetHash();
 		else
 			return BF_GetHash(value);
 	}
 };
+
+
+template <BF::HashCombinatorPolicy Combinator>
+struct std::hash<BF::BasicHash<Combinator>> {							// a hash value is hashable, e.g. when it was precomputed
+	[[nodiscard]]
+	constexpr static std::size_t operator()(const BF::BasicHash<Combinator>& value) {
+		return value;
+	}
+};
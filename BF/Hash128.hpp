@@ -0,0 +1,295 @@
+// 128 bit hashing, for using the hash value as the identity of the hashed content (fingerprinting, deduplication).
+
+
+#pragma once
+#include <array>
+#include <bit>
+#include <cstring>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include "BF/Hash.hpp"
+
+
+namespace BF {
+
+
+class Hash128;
+
+
+// === Implementation details ==========================================================================================
+
+namespace ImpHash128 {
+
+
+// https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp (MurmurHash3_x64_128)
+// The input is a stream of 64 bit words, every two of them make a block.
+class WordHasher {
+public:
+	constexpr void AddWord(UInt64 word) {
+		if (mCount++ % 2 == 0) {
+			mPending = word;
+		} else {
+			AddBlock(mPending, word);
+		}
+	}
+
+	// The bytes are packed into little endian words, then the size is added.
+	constexpr void AddBytes(const auto* data, std::size_t size) {
+		static_assert(sizeof(*data) == 1);
+
+		std::size_t i = 0;
+		for (; i + 8 <= size; i += 8)
+			AddWord(LoadWord(data + i, 8));
+
+		if (i < size)
+			AddWord(LoadWord(data + i, size - i));
+
+		AddWord(size);
+	}
+
+	constexpr void Get(UInt64& low, UInt64& high) const {
+		UInt64 h1 = mH1;
+		UInt64 h2 = mH2;
+
+		if (mCount % 2 == 1)
+			h1 ^= std::rotl(mPending * C1, 31) * C2;
+
+		h1 ^= mCount;
+		h2 ^= mCount;
+		h1 += h2;
+		h2 += h1;
+		h1  = FMix64(h1);
+		h2  = FMix64(h2);
+		h1 += h2;
+		h2 += h1;
+
+		low  = h1;
+		high = h2;
+	}
+
+private:
+	constexpr static UInt64 C1   = 0x87c37b91114253d5;
+	constexpr static UInt64 C2   = 0x4cf5ad432745937f;
+	constexpr static UInt64 Seed = 0x9e3779b97f4a7c15;				// the hash of no values is not zero
+
+	constexpr void AddBlock(UInt64 k1, UInt64 k2) {
+		mH1 ^= std::rotl(k1 * C1, 31) * C2;
+		mH1  = (std::rotl(mH1, 27) + mH2) * 5 + 0x52dce729;
+		mH2 ^= std::rotl(k2 * C2, 33) * C1;
+		mH2  = (std::rotl(mH2, 31) + mH1) * 5 + 0x38495ab5;
+	}
+
+	constexpr static UInt64 LoadWord(const auto* data, std::size_t size) {
+		UInt64 word = 0;
+		if consteval {
+			for (std::size_t i = 0; i < size; i++)
+				word |= UInt64(static_cast<UChar>(data[i])) << (8 * i);
+		} else {
+			std::memcpy(&word, data, size);
+			if constexpr (std::endian::native == std::endian::big)
+				word = std::byteswap(word);
+		}
+
+		return word;
+	}
+
+	UInt64      mH1      = Seed;
+	UInt64      mH2      = Seed;
+	UInt64      mPending = 0;
+	std::size_t mCount   = 0;
+};
+
+
+template <class Type>
+concept HasGetHash128Method = requires (const Type& value) {
+	{ value.BF_GetHash128() } -> std::same_as<Hash128>;
+};
+
+
+template <class Type>
+concept HasGetHash128Function = requires (const Type& value) {
+	{ BF_GetHash128(value) } -> std::same_as<Hash128>;
+};
+
+
+template <class Type>
+constexpr void AddValue(WordHasher& hasher, const Type& value);
+
+
+}	// namespace ImpHash128
+
+
+// === class Hash128 ===================================================================================================
+// Constructed like 'BF::Hash': from the values to hash. But unlike 'BF::Hash', the values are not reduced to a
+// 'std::size_t' by 'std::hash' first, that would limit the result to 64 bits. The values are absorbed as follows:
+//   - Integral and enum values: one 64 bit word. Floating point values: their bit pattern (0 and -0 are the same).
+//   - Strings (anything convertible to 'std::string_view'): their characters and their size.
+//   - 'BF::Hash128': its two words. A type can be made hashable by a 'BF_GetHash128()' method or function, which
+//     returns a 'BF::Hash128', constructed from its members.
+//   - Types with 'BF_HashAsBytes' (see 'BF::HashesAsBytes'): their bytes.
+//   - 'BF::Hash128Range' and 'BF::Hash128RawMemory' wrappers: the whole content. There is no sampling like in
+//     'BF::HashRange', since the hash value identifies the content.
+//
+// The hash function is MurmurHash3 (x64, 128 bit) over the absorbed words. The chance of two different contents having
+// the same hash value is about 2^-128, but it isn't cryptographic: it is not collision resistant against adversarial
+// inputs. Use it for dropping the full key comparison only if the inputs are not chosen by an attacker. The values are
+// stable across processes and platforms for integers, strings and raw memory of the same byte order.
+
+class Hash128 final {
+public:
+	constexpr Hash128(const auto&... values) {
+		ImpHash128::WordHasher hasher;
+		( ..., ImpHash128::AddValue(hasher, values) );
+		hasher.Get(mLow, mHigh);
+	}
+
+	constexpr UInt64 GetLow() const  { return mLow; }
+	constexpr UInt64 GetHigh() const { return mHigh; }
+
+	constexpr bool operator==(const Hash128&) const = default;
+
+private:
+	UInt64 mLow;
+	UInt64 mHigh;
+};
+
+
+// === class Hash128Range ==============================================================================================
+// All elements of an input range. The elements of a contiguous range are hashed as bytes, if they are integers, enums
+// or 'BF_HashAsBytes' types, otherwise one by one, like the arguments of 'BF::Hash128'.
+
+template <std::ranges::input_range Range>
+class Hash128Range final {
+public:
+	constexpr explicit Hash128Range(const Range& range) : mRange(range) {}
+
+private:
+	template <class Type>
+	friend constexpr void ImpHash128::AddValue(ImpHash128::WordHasher& hasher, const Type& value);
+
+	const Range& mRange;
+};
+
+
+// === class Hash128RawMemory ==========================================================================================
+
+class Hash128RawMemory final {
+public:
+	template <class Type>
+	explicit Hash128RawMemory(const Type& value) :
+		mSpan(BF::AsByteArray(value))
+	{
+	}
+
+	explicit Hash128RawMemory(const void* begin, std::size_t size) :
+		mSpan(static_cast<const std::byte*>(begin), size)
+	{
+	}
+
+private:
+	template <class Type>
+	friend constexpr void ImpHash128::AddValue(ImpHash128::WordHasher& hasher, const Type& value);
+
+	const std::span<const std::byte> mSpan;
+};
+
+
+// === Implementation details ==========================================================================================
+
+namespace ImpHash128 {
+
+
+template <class Type>
+constexpr bool IsHash128Range = false;
+
+template <class Range>
+constexpr bool IsHash128Range<Hash128Range<Range>> = true;
+
+
+template <class Type>
+constexpr bool IsWordSized = std::is_integral_v<Type> || std::is_enum_v<Type>;
+
+
+template <class Type>
+constexpr void AddValue(WordHasher& hasher, const Type& value)
+{
+	if constexpr (std::is_same_v<Type, Hash128>) {
+		hasher.AddWord(value.GetLow());
+		hasher.AddWord(value.GetHigh());
+	} else if constexpr (IsWordSized<Type>) {
+		static_assert(sizeof(Type) <= sizeof(UInt64), "'Type' is too large.");
+		hasher.AddWord(static_cast<UInt64>(value));
+	} else if constexpr (std::is_floating_point_v<Type>) {
+		static_assert(sizeof(Type) <= sizeof(UInt64), "'Type' is too large.");
+		using Bits = std::conditional_t<sizeof(Type) == 8, UInt64, UInt32>;
+		hasher.AddWord(value == 0 ? 0 : std::bit_cast<Bits>(value));
+	} else if constexpr (std::is_convertible_v<const Type&, std::string_view>) {
+		const std::string_view str = value;
+		hasher.AddBytes(str.data(), str.size());
+	} else if constexpr (HasGetHash128Method<Type>) {
+		AddValue(hasher, value.BF_GetHash128());
+	} else if constexpr (HasGetHash128Function<Type>) {
+		AddValue(hasher, BF_GetHash128(value));
+	} else if constexpr (HashesAsBytes<Type>) {
+		const auto& bytes = BF::AsByteArray(value);
+		hasher.AddBytes(bytes, sizeof(bytes));
+	} else if constexpr (std::is_same_v<Type, Hash128RawMemory>) {
+		hasher.AddBytes(value.mSpan.data(), value.mSpan.size());
+	} else if constexpr (IsHash128Range<Type>) {
+		using Element = std::remove_cvref_t<std::ranges::range_reference_t<decltype(value.mRange)>>;
+		constexpr bool AsBytes = std::ranges::contiguous_range<decltype(value.mRange)> && (IsWordSized<Element> || HashesAsBytes<Element>);
+
+		if constexpr (AsBytes) {
+			if consteval {											// the same words as 'AddBytes()' at run time
+				std::size_t byteCount = 0;
+				UInt64      word      = 0;
+				for (const Element& element : value.mRange) {
+					for (const UChar byte : std::bit_cast<std::array<UChar, sizeof(Element)>>(element)) {
+						word |= UInt64(byte) << (8 * (byteCount % 8));
+						if (++byteCount % 8 == 0) {
+							hasher.AddWord(word);
+							word = 0;
+						}
+					}
+				}
+
+				if (byteCount % 8 != 0)
+					hasher.AddWord(word);
+
+				hasher.AddWord(byteCount);
+			} else {
+				const std::span elements(value.mRange);
+				hasher.AddBytes(reinterpret_cast<const std::byte*>(elements.data()), elements.size_bytes());
+			}
+
+			return;
+		}
+
+		UInt64 size = 0;
+		for (const auto& element : value.mRange) {
+			AddValue(hasher, element);
+			size++;
+		}
+		hasher.AddWord(size);
+	} else {
+		static_assert(false, "'Type' is not hashable by 'BF::Hash128'.");
+	}
+}
+
+
+}	// namespace ImpHash128
+
+
+}	// namespace BF
+
+
+// === std::hash specializations =======================================================================================
+
+template <>
+struct std::hash<BF::Hash128> {
+	[[nodiscard]]
+	constexpr static std::size_t operator()(const BF::Hash128& value) {
+		return static_cast<std::size_t>(value.GetLow());
+	}
+};
@@ -0,0 +1,109 @@
+// Hashing many keys at once.
+
+
+#pragma once
+#include <span>
+#include <type_traits>
+#include "BF/Assert.hpp"
+#include "BF/Hash.hpp"
+#include "BF/HashBytes.hpp"
+
+
+namespace BF {
+
+
+// === Implementation details ==========================================================================================
+
+namespace ImpHash {
+
+
+template <class Combinator>
+struct AvalancheOf;
+
+template <class Combinator>
+struct AvalancheOf<Avalanche<Combinator>> : std::type_identity<Combinator> {};
+
+
+#if defined(IMP_BF_X64)
+
+// The low 64 bits of the 4 products. AVX2 has no 64 bit multiplication, so it is made of three 32 x 32 -> 64 bit ones.
+IMP_BF_TARGET_AVX2
+inline __m256i Mul64x4(__m256i a, UInt64 factor)
+{
+	const __m256i low   = _mm256_set1_epi64x(static_cast<long long>(factor & 0xffffffff));
+	const __m256i high  = _mm256_set1_epi64x(static_cast<long long>(factor >> 32));
+	const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), low), _mm256_mul_epu32(a, high));
+	return _mm256_add_epi64(_mm256_mul_epu32(a, low), _mm256_slli_epi64(cross, 32));
+}
+
+
+// 'BF::FMix64()' of 4 hash values at once.
+IMP_BF_TARGET_AVX2
+inline __m256i FMix64x4(__m256i hash)
+{
+	hash = _mm256_xor_si256(hash, _mm256_srli_epi64(hash, 33));
+	hash = Mul64x4(hash, 0xff51afd7ed558ccd);
+	hash = _mm256_xor_si256(hash, _mm256_srli_epi64(hash, 33));
+	hash = Mul64x4(hash, 0xc4ceb9fe1a85ec53);
+	hash = _mm256_xor_si256(hash, _mm256_srli_epi64(hash, 33));
+	return hash;
+}
+
+
+// 'HashBatch<Avalanche<Inner>>()' of the first 'size / 4 * 4' keys. Returns the number of keys hashed.
+template <class Inner, class Type>
+IMP_BF_TARGET_AVX2
+std::size_t HashBatchAvalancheAVX2(const Type* input, std::size_t* output, std::size_t size)
+{
+	const auto innerHash = [input](std::size_t index) {
+		return static_cast<long long>(Inner::Single(std::hash<Type>()(input[index])));
+	};
+
+	std::size_t i = 0;
+	for (; i + 4 <= size; i += 4) {
+		// Built in registers: storing the 4 values and loading them as one vector would stall store forwarding.
+		const __m256i hashes = _mm256_set_epi64x(innerHash(i + 3), innerHash(i + 2), innerHash(i + 1), innerHash(i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), FMix64x4(hashes));
+	}
+
+	return i;
+}
+
+#endif
+
+
+}	// namespace ImpHash
+
+
+// === HashBatch() =====================================================================================================
+// 'out[i]' will be the same as the hash value of 'BF::BasicHash<Combinator>(in[i])'. For 'BF::Avalanche<...>', if the
+// CPU has AVX2 (detected at runtime, in every x64 build), the 'BF::FMix64()' step runs on 4 keys per instruction. The
+// other combinators are hashed key by key, like 'BF::Hash' does: the 128 bit multiplications of 'WideMulCombinator'
+// and 'MultiLaneCombinator' have no AVX2 equivalent, and 'FNV1aCombinator' returns the 'std::hash' value of a single
+// key unchanged, so there is nothing to vectorize.
+
+template <HashCombinatorPolicy Combinator = FNV1aCombinator, class Type>
+void HashBatch(std::span<const Type> in, std::span<std::size_t> out)
+{
+	static_assert(StdHashable<Type>, "'Type' is not hashable.");
+	BF_ASSERT(in.size() == out.size());
+
+	const std::size_t size   = in.size() < out.size() ? in.size() : out.size();
+	const Type*       input  = in.data();
+	std::size_t*      output = out.data();
+
+	std::size_t i = 0;
+
+#if defined(IMP_BF_X64)
+	if constexpr (requires { typename ImpHash::AvalancheOf<Combinator>::type; }) {
+		if (ImpHash::HasAVX2())
+			i = ImpHash::HashBatchAvalancheAVX2<typename ImpHash::AvalancheOf<Combinator>::type>(input, output, size);
+	}
+#endif
+
+	for (; i < size; i++)
+		output[i] = Combinator::Single(std::hash<Type>()(input[i]));
+}
+
+
+}	// namespace BF
@@ -0,0 +1,307 @@
+// Hashing a contiguous memory block of bytes in one pass.
+
+
+#pragma once
+#include <array>
+#include <bit>
+#include <cstring>
+#include <span>
+#include "BF/BasicMath.hpp"
+
+// The AVX2 loops are compiled in every x64 build, and selected at runtime by 'ImpHash::HasAVX2()'. MSVC compiles AVX2
+// intrinsics without '/arch:AVX2', GCC and Clang only in functions marked with 'IMP_BF_TARGET_AVX2'.
+#if defined(_M_X64) || defined(__x86_64__)
+	#include <immintrin.h>
+	#define IMP_BF_X64
+
+	#if defined(__GNUC__) || defined(__clang__)
+		#define IMP_BF_TARGET_AVX2		__attribute__((target("avx2")))
+	#else
+		#define IMP_BF_TARGET_AVX2
+	#endif
+#endif
+
+
+namespace BF {
+
+
+// === Implementation details ==========================================================================================
+
+namespace ImpHash {
+
+
+#if defined(IMP_BF_X64)
+
+bool DetectAVX2();
+
+
+// True if both the CPU and the OS support AVX2. Detected at the first call, with 'cpuid'.
+inline bool HasAVX2()
+{
+#if defined(__AVX2__)
+	return true;
+#else
+	static const bool hasAVX2 = DetectAVX2();
+	return hasAVX2;
+#endif
+}
+
+#endif
+
+
+// https://github.com/wangyi-fudan/wyhash (final version 4)
+// Reads 8 bytes per load. Above 48 bytes it works on three independent lanes, so the multiplications can overlap. The
+// loads are little endian on every platform, so the result only depends on the bytes and the seed. 'BF::StableHash'
+// has its own frozen copy, so this one can be tuned.
+class BytesHasher {
+public:
+	static UInt64 Hash(const std::byte* data, std::size_t size, UInt64 seed = 0) {
+		return HashInline(data, size, seed);
+	}
+
+	// The same, always inlined. With a compile time 'size' (e.g. of a 'BF_HashAsBytes' type) the branches fold away.
+	BF_FORCEINLINE
+	static UInt64 HashInline(const std::byte* data, std::size_t size, UInt64 seed = 0) {
+		seed ^= UMul128Fold(seed ^ Secret0, Secret1);
+
+		UInt64 a = 0;
+		UInt64 b = 0;
+
+		if (size <= 16) {
+			if (size >= 4) {
+				const std::size_t shift = (size >> 3) << 2;
+				a = (Read4(data) << 32) | Read4(data + shift);
+				b = (Read4(data + size - 4) << 32) | Read4(data + size - 4 - shift);
+			} else if (size > 0) {
+				a = Read3(data, size);
+			}
+		} else {
+			const std::byte* p         = data;
+			std::size_t      remaining = size;
+
+			if (remaining > 48) {
+				UInt64 seed1 = seed;
+				UInt64 seed2 = seed;
+
+				do {
+					seed  = UMul128Fold(Read8(p)      ^ Secret1, Read8(p + 8)  ^ seed);
+					seed1 = UMul128Fold(Read8(p + 16) ^ Secret2, Read8(p + 24) ^ seed1);
+					seed2 = UMul128Fold(Read8(p + 32) ^ Secret3, Read8(p + 40) ^ seed2);
+					p         += 48;
+					remaining -= 48;
+				} while (remaining > 48);
+
+				seed ^= seed1 ^ seed2;
+			}
+
+			while (remaining > 16) {
+				seed = UMul128Fold(Read8(p) ^ Secret1, Read8(p + 8) ^ seed);
+				p         += 16;
+				remaining -= 16;
+			}
+
+			a = Read8(p + remaining - 16);
+			b = Read8(p + remaining - 8);
+		}
+
+		a ^= Secret1;
+		b ^= seed;
+		a  = UMul128(a, b, b);
+
+		return UMul128Fold(a ^ Secret0 ^ size, b ^ Secret1);
+	}
+
+private:
+	static UInt64 Read8(const std::byte* p) {
+		UInt64 value;
+		std::memcpy(&value, p, sizeof(value));
+		return ToLittleEndian(value);
+	}
+
+	static UInt64 Read4(const std::byte* p) {
+		UInt32 value;
+		std::memcpy(&value, p, sizeof(value));
+		return ToLittleEndian(value);
+	}
+
+	template <class Type>
+	static Type ToLittleEndian(Type value) {
+		if constexpr (std::endian::native == std::endian::big)
+			return std::byteswap(value);
+		else
+			return value;
+	}
+
+	static UInt64 Read3(const std::byte* p, std::size_t size) {		// 'size' is 1, 2 or 3
+		return (UInt64(p[0]) << 16) | (UInt64(p[size >> 1]) << 8) | UInt64(p[size - 1]);
+	}
+
+	constexpr static UInt64 Secret0 = 0x2d358dccaa6c78a5;
+	constexpr static UInt64 Secret1 = 0x8bb84b93962eacc9;
+	constexpr static UInt64 Secret2 = 0x4b33a62ed433d4a3;
+	constexpr static UInt64 Secret3 = 0x4d5a2da51de1aa47;
+};
+
+
+// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md (the long input loop of XXH3, not bit-compatible)
+// For long inputs. Eight 64 bit accumulators absorb 64 byte stripes, each lane with a 32 x 32 -> 64 bit multiplication
+// and the input of the neighbour lane, 4 lanes per AVX2 instruction. After every block of 16 stripes the accumulators
+// are scrambled. A partial last stripe is handled by hashing the last 64 bytes. The AVX2 loop is used if the CPU has
+// AVX2, the scalar loop otherwise; they give the same result, so the hash value doesn't depend on the build or the CPU.
+class StripeHasher {
+public:
+	constexpr static std::size_t MinSize = 1024;				// below this, 'BytesHasher' is faster, even with AVX2
+
+	static UInt64 Hash(const std::byte* data, std::size_t size, UInt64 seed = 0) {
+#if defined(IMP_BF_X64)
+		if (HasAVX2())
+			return HashWith<AccumulateAVX2>(data, size, seed);
+#endif
+
+		return HashWith<AccumulateScalar>(data, size, seed);
+	}
+
+	static UInt64 HashScalar(const std::byte* data, std::size_t size, UInt64 seed = 0) {	// for testing
+		return HashWith<AccumulateScalar>(data, size, seed);
+	}
+
+private:
+	constexpr static std::size_t LaneCount       = 8;
+	constexpr static std::size_t StripeSize      = LaneCount * sizeof(UInt64);
+	constexpr static std::size_t StripesPerBlock = 16;
+	constexpr static std::size_t SecretSize      = StripesPerBlock + LaneCount;	// every stripe uses the next offset
+
+	constexpr static UInt64 Prime32_1 = 0x9e3779b1;
+	constexpr static UInt64 Prime32_2 = 0x85ebca77;
+	constexpr static UInt64 Prime32_3 = 0xc2b2ae3d;
+	constexpr static UInt64 Prime64_1 = 0x9e3779b185ebca87;
+	constexpr static UInt64 Prime64_2 = 0xc2b2ae3d27d4eb4f;
+	constexpr static UInt64 Prime64_3 = 0x165667b19e3779f9;
+	constexpr static UInt64 Prime64_4 = 0x85ebca77c2b2ae63;
+	constexpr static UInt64 Prime64_5 = 0x27d4eb2f165667c5;
+
+	// SplitMix64 outputs, so there is nothing up the sleeve.
+	constexpr static std::array<UInt64, SecretSize> DefaultSecret = [] {
+		std::array<UInt64, SecretSize> secret;
+		UInt64 state = 0;
+		for (UInt64& word : secret) {
+			state += 0x9e3779b97f4a7c15;
+			UInt64 z = state;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+			word = z ^ (z >> 31);
+		}
+
+		return secret;
+	}();
+
+	using AccumulateFunc = void (UInt64 (&acc)[LaneCount], const std::byte* data, std::size_t count,
+								 const UInt64* secret);
+
+	template <AccumulateFunc Accumulate>
+	static UInt64 HashWith(const std::byte* data, std::size_t size, UInt64 seed) {
+		UInt64 secret[SecretSize];
+		for (std::size_t i = 0; i < SecretSize; i++)
+			secret[i] = DefaultSecret[i] + ((i % 2 == 0) ? seed : 0 - seed);
+
+		UInt64 acc[LaneCount] = {
+			Prime32_3, Prime64_1, Prime64_2, Prime64_3, Prime64_4, Prime32_2, Prime64_5, Prime32_1
+		};
+
+		const std::size_t stripeCount = (size - 1) / StripeSize;	// the last (possibly partial) stripe is separate
+		const std::size_t blockCount  = stripeCount / StripesPerBlock;
+
+		for (std::size_t b = 0; b < blockCount; b++) {
+			Accumulate(acc, data + b * StripesPerBlock * StripeSize, StripesPerBlock, secret);
+
+			Scramble(acc, secret[SecretSize - 1]);
+		}
+
+		Accumulate(acc, data + blockCount * StripesPerBlock * StripeSize, stripeCount % StripesPerBlock, secret);
+		Accumulate(acc, data + size - StripeSize, 1, secret + StripesPerBlock - 1);
+
+		UInt64 result = size * Prime64_1;
+		for (std::size_t i = 0; i < LaneCount; i += 2)
+			result += UMul128Fold(acc[i] ^ secret[i + 1], acc[i + 1] ^ secret[i + 2]);
+
+		result ^= result >> 37;										// XXH3's avalanche
+		result *= 0x165667919e3779f9;
+		result ^= result >> 32;
+		return result;
+	}
+
+	// Stripe 's' uses the secret words from 's'. The bytes are read in little endian order.
+	static void AccumulateScalar(UInt64 (&acc)[LaneCount], const std::byte* data, std::size_t count,
+								 const UInt64* secret) {
+		for (std::size_t s = 0; s < count; s++) {
+			UInt64 value[LaneCount];
+			std::memcpy(value, data + s * StripeSize, StripeSize);
+
+			for (std::size_t i = 0; i < LaneCount; i++) {
+				if constexpr (std::endian::native == std::endian::big)
+					value[i] = std::byteswap(value[i]);
+			}
+
+			for (std::size_t i = 0; i < LaneCount; i++) {
+				const UInt64 mixed = value[i] ^ secret[s + i];
+				acc[i] += (mixed & 0xffffffff) * (mixed >> 32) + value[i ^ 1];		// 'i ^ 1' is the neighbour lane
+			}
+		}
+	}
+
+#if defined(IMP_BF_X64)
+
+	// The same as 'AccumulateScalar()', 4 lanes per instruction. The accumulators stay in registers.
+	IMP_BF_TARGET_AVX2
+	static void AccumulateAVX2(UInt64 (&acc)[LaneCount], const std::byte* data, std::size_t count,
+							   const UInt64* secret) {
+		__m256i acc0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc));
+		__m256i acc1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc + 4));
+		for (std::size_t s = 0; s < count; s++) {
+			acc0 = StepAVX2(acc0, data + s * StripeSize,      secret + s);
+			acc1 = StepAVX2(acc1, data + s * StripeSize + 32, secret + s + 4);
+		}
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc),     acc0);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + 4), acc1);
+	}
+
+	IMP_BF_TARGET_AVX2
+	static __m256i StepAVX2(__m256i lanes, const std::byte* input, const UInt64* key) {
+		const __m256i value   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input));
+		const __m256i mixed   = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(key)));
+		const __m256i product = _mm256_mul_epu32(mixed, _mm256_srli_epi64(mixed, 32));
+		const __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));			// the neighbour lane
+		return _mm256_add_epi64(lanes, _mm256_add_epi64(product, swapped));
+	}
+
+#endif
+
+	static void Scramble(UInt64 (&acc)[LaneCount], UInt64 secret) {
+		for (std::size_t i = 0; i < LaneCount; i++) {
+			acc[i] ^= acc[i] >> 47;
+			acc[i] ^= secret;
+			acc[i] *= Prime32_1;
+		}
+	}
+};
+
+
+}	// namespace ImpHash
+
+
+// === HashBytes() =====================================================================================================
+// Hashes all bytes of 'bytes'. Short inputs go to 'ImpHash::BytesHasher' (wyhash), long ones to
+// 'ImpHash::StripeHasher' (an XXH3-like stripe loop, with AVX2 if the CPU has it). The result only depends on the bytes
+// and the seed, but it can change between versions of this library, use 'BF::StableHash' for persisted values.
+
+inline UInt64 HashBytes(std::span<const std::byte> bytes, UInt64 seed = 0)
+{
+	if (bytes.size() >= ImpHash::StripeHasher::MinSize)
+		return ImpHash::StripeHasher::Hash(bytes.data(), bytes.size(), seed);
+
+	return ImpHash::BytesHasher::Hash(bytes.data(), bytes.size(), seed);
+}
+
+
+}	// namespace BF
@@ -0,0 +1,149 @@
+#include "BF/HashFile.hpp"
+
+#include <fstream>
+#include <vector>
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+
+namespace BF {
+
+
+namespace {
+
+
+// A read-only view of a whole regular file. It is empty if the file can't be mapped.
+class MappedFile {
+public:
+	explicit MappedFile(const std::filesystem::path& path);
+	~MappedFile();
+
+	MappedFile(const MappedFile&)            = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool IsMapped() const {
+		return mData != nullptr;
+	}
+
+	std::span<const std::byte> GetBytes() const {
+		return { static_cast<const std::byte*>(mData), mSize };
+	}
+
+private:
+	void*       mData = nullptr;
+	std::size_t mSize = 0;
+};
+
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+	const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+									FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && static_cast<UInt64>(size.QuadPart) <= MaxUIntPtr) {
+		if (const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+			mData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);			// the view keeps the mapping alive
+			mSize = mData != nullptr ? static_cast<std::size_t>(size.QuadPart) : 0;
+			CloseHandle(mapping);
+		}
+	}
+
+	CloseHandle(file);
+}
+
+
+MappedFile::~MappedFile()
+{
+	if (mData != nullptr)
+		UnmapViewOfFile(mData);
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+	const int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (file < 0)
+		return;
+
+	struct stat status;
+	if (fstat(file, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+		const std::size_t size = static_cast<std::size_t>(status.st_size);
+		void* const       data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (data != MAP_FAILED) {
+			madvise(data, size, MADV_SEQUENTIAL);						// a hint, aggressive read-ahead
+			mData = data;
+			mSize = size;
+		}
+	}
+
+	close(file);														// the mapping stays valid
+}
+
+
+MappedFile::~MappedFile()
+{
+	if (mData != nullptr)
+		munmap(mData, mSize);
+}
+
+#endif
+
+
+}	// namespace
+
+
+std::optional<UInt64> ImpHash::HashFileByReading(const std::filesystem::path& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return std::nullopt;
+
+	std::vector<std::byte> leaf(TreeLeafSize);
+	std::vector<UInt64>    leafHashes;
+	UInt64                 size = 0;
+	while (true) {
+		file.read(reinterpret_cast<char*>(leaf.data()), static_cast<std::streamsize>(leaf.size()));
+
+		const std::size_t readSize = static_cast<std::size_t>(file.gcount());	// only the last leaf is shorter
+		if (readSize > 0) {
+			leafHashes.push_back(HashBytes(std::span(leaf).first(readSize)));
+			size += readSize;
+		}
+
+		if (readSize < leaf.size())
+			break;
+	}
+
+	if (file.bad())
+		return std::nullopt;
+
+	return CombineTreeLeaves(leafHashes, size);
+}
+
+
+std::optional<UInt64> HashFile(const std::filesystem::path& path, unsigned threadCount)
+{
+	const MappedFile file(path);
+	if (file.IsMapped())
+		return TreeHash(file.GetBytes(), threadCount);
+
+	return ImpHash::HashFileByReading(path);
+}
+
+
+}	// namespace BF
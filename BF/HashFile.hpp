@@ -0,0 +1,40 @@
+// Hashing the contents of files, e.g. to fingerprint them for validating caches.
+
+
+#pragma once
+#include <filesystem>
+#include <optional>
+#include "BF/TreeHash.hpp"
+
+
+namespace BF {
+
+
+// === Implementation details ==========================================================================================
+
+namespace ImpHash {
+
+
+// The fallback of 'BF::HashFile()': reads the file leaf by leaf into a buffer, on the calling thread.
+std::optional<UInt64> HashFileByReading(const std::filesystem::path& path);
+
+
+}	// namespace ImpHash
+
+
+// === HashFile() ======================================================================================================
+// Returns the same value as 'BF::TreeHash()' of the contents of the file, or 'std::nullopt' if it can't be read. The
+// file is memory-mapped ('mmap()' with 'MADV_SEQUENTIAL', or 'MapViewOfFile()' on Windows) and hashed in place on
+// 'threadCount' threads, without copying it. Files which can't be mapped (e.g. empty files and pipes) are read
+// sequentially, one 256 KiB leaf at a time.
+//
+// The value doesn't depend on the build or the CPU (e.g. '/arch:AVX2' or not), so it can be stored, e.g. to validate a
+// cache at the next startup. A new version of this library can change it, which invalidates the stored values once.
+//
+// The file must not be modified while it is hashed: a mapped file can change under the hash, or become shorter, which
+// is a crash (SIGBUS) on POSIX.
+
+std::optional<UInt64> HashFile(const std::filesystem::path& path, unsigned threadCount = 0);
+
+
+}	// namespace BF
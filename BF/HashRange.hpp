@@ -2,6 +2,8 @@
 
 
 #pragma once
+#include <algorithm>
+#include <bit>
 #include <random>
 #include <ranges>
 #include <span>
@@ -12,63 +14,277 @@
 namespace BF {
 
 
+// === Sampling policies ===============================================================================================
+// Ranges longer than 16 elements are hashed by 'BF::HashRange' from a sample: the size, the first and last 4 elements,
+// and 'GetSampleCount(size)' elements between them. The interior is split into that many equal intervals, and one
+// element is taken from each one, at the offset returned by 'Next(intervalSize)' (which must be less than
+// 'intervalSize'). The sampler is constructed from the hash value of the already absorbed elements, so the positions
+// depend on the contents, but they are the same for equal ranges. 'GetSampleCount()' must be 'constexpr', and positive.
+//
+// | Sampler                       | Positions                                           | Sample count         |
+// | ----------------------------- | --------------------------------------------------- | -------------------- |
+// | 'RanluxSampler' (the default) | 'std::ranlux48_base' engine                         | 8                    |
+// | 'SplitMixSampler'             | SplitMix64 counter, no engine state to construct    | 8                    |
+// | 'StrideSampler'               | the middle of every interval, no randomness at all  | 8                    |
+// | 'LogSampler'                  | SplitMix64 counter                                  | 2 * bit_width(size)  |
+
+template <class Type>
+concept RangeSamplingPolicy = requires (Type sampler, UInt64 value) {
+	Type(value);
+	{ sampler.Next(value) }         -> std::same_as<UInt64>;
+	{ Type::GetSampleCount(value) } -> std::same_as<UInt64>;
+} && (Type::GetSampleCount(17) > 0);								// the smallest sampled size
+
+
+class RanluxSampler {
+public:
+	explicit RanluxSampler(UInt64 seed) : mRng(seed) {}
+
+	UInt64 Next(UInt64 intervalSize) {
+		return mRng() % intervalSize;
+	}
+
+	constexpr static UInt64 GetSampleCount(UInt64) {
+		return 8;
+	}
+
+private:
+	std::ranlux48_base mRng;
+};
+
+
+// https://prng.di.unimi.it/splitmix64.c
+// The offset is mapped into the interval with a multiplication instead of a division.
+class SplitMixSampler {
+public:
+	constexpr explicit SplitMixSampler(UInt64 seed) : mState(seed) {}
+
+	constexpr UInt64 Next(UInt64 intervalSize) {
+		mState += 0x9e3779b97f4a7c15;
+
+		UInt64 z = mState;
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+		z =  z ^ (z >> 31);
+
+		UInt64 offset = 0;
+		UMul128(z, intervalSize, offset);
+		return offset;
+	}
+
+	constexpr static UInt64 GetSampleCount(UInt64) {
+		return 8;
+	}
+
+private:
+	UInt64 mState;
+};
+
+
+class StrideSampler {
+public:
+	constexpr explicit StrideSampler(UInt64) {}
+
+	constexpr static UInt64 Next(UInt64 intervalSize) {
+		return intervalSize / 2;
+	}
+
+	constexpr static UInt64 GetSampleCount(UInt64) {
+		return 8;
+	}
+};
+
+
+class LogSampler : public SplitMixSampler {
+public:
+	using SplitMixSampler::SplitMixSampler;
+
+	constexpr static UInt64 GetSampleCount(UInt64 size) {
+		return 2 * static_cast<UInt64>(std::bit_width(size));
+	}
+};
+
+
 // === Implementation details ==========================================================================================
 
 namespace ImpHash {
 
 
-template <std::ranges::random_access_range Range>
-constexpr std::size_t GetRangeHash(const Range& range)
-{
-	const std::random_access_iterator auto begin = std::ranges::begin(range);
-	const UInt64                           size  = std::ranges::size(range);
+class StableHashState;
 
-	ImpHash::HashCombinator hc;
-	hc.Add(size);
 
-	if (size <= 16) {
-		for (const auto& value : range)
+// Absorbs the size and a sample of the elements into 'hc'. A 'HashState' has 'Add(values...)' and 'Get()'. Forward
+// ranges are sampled at the same positions as random access ranges, walking with one iterator (and one more for the
+// last elements), so e.g. a 'std::list' hashes like a 'std::vector' with the same elements. Ranges without a size (e.g.
+// 'std::forward_list' or a filtered view) are absorbed completely in one pass, followed by the number of elements.
+template <RangeSamplingPolicy Sampler = RanluxSampler, class HashState, std::ranges::forward_range Range>
+constexpr void AddRangeSample(HashState& hc, const Range& range)
+{
+	if constexpr (!std::ranges::sized_range<const Range&>) {
+		UInt64 size = 0;
+		for (const auto& value : range) {
 			hc.Add(value);
+			size++;
+		}
+
+		hc.Add(size);
 	} else {
-		hc.Add(begin[0],        begin[1],        begin[2],        begin[3]);
-		hc.Add(begin[size - 4], begin[size - 3], begin[size - 2], begin[size - 1]);
-
-		std::ranlux48_base rng(hc.Get());
-		const UInt64 baseIntervalSize = (size - 8) / 8;
-		const UInt8  remainder        = (size - 8) % 8;
-		UInt64       start            = 4;
-
-		for (UInt8 i = 0; i < 8; i++) {
-			const UInt64 intervalSize = baseIntervalSize + (i < remainder);
-			hc.Add(begin[start + rng() % intervalSize]);
-			start += intervalSize;
+		const UInt64 size = std::ranges::size(range);
+
+		hc.Add(size);
+
+		if (size <= 16) {
+			for (const auto& value : range)
+				hc.Add(value);
+		} else {
+			using Difference = std::ranges::range_difference_t<const Range&>;
+
+			std::forward_iterator auto it = std::ranges::begin(range);
+			for (int i = 0; i < 4; i++, ++it)
+				hc.Add(*it);
+
+			std::forward_iterator auto last = [&] {
+				if constexpr (std::ranges::bidirectional_range<const Range&> && std::ranges::common_range<const Range&>)
+					return std::ranges::prev(std::ranges::end(range), 4);
+				else
+					return std::ranges::next(it, static_cast<Difference>(size - 8));
+			}();
+
+			for (int i = 0; i < 4; i++, ++last)
+				hc.Add(*last);
+
+			Sampler      sampler(hc.Get());
+			const UInt64 sampleCount      = std::clamp<UInt64>(Sampler::GetSampleCount(size), 1, size - 8);
+			const UInt64 baseIntervalSize = (size - 8) / sampleCount;
+			const UInt64 remainder        = (size - 8) % sampleCount;
+			UInt64       start            = 4;
+			UInt64       position         = 4;						// of 'it'
+
+			for (UInt64 i = 0; i < sampleCount; i++) {
+				const UInt64 intervalSize = baseIntervalSize + (i < remainder);
+				const UInt64 sample       = start + sampler.Next(intervalSize);
+
+				std::ranges::advance(it, static_cast<Difference>(sample - position));
+				position = sample;
+				hc.Add(*it);
+				start += intervalSize;
+			}
 		}
 	}
+}
 
+
+template <HashCombinatorPolicy Combinator = FNV1aCombinator, RangeSamplingPolicy Sampler = RanluxSampler, std::ranges::forward_range Range>
+constexpr std::size_t GetRangeHash(const Range& range)
+{
+	ImpHash::HashCombinator<Combinator> hc;
+	AddRangeSample<Sampler>(hc, range);
+	return hc.Get();
+}
+
+
+// The seed also changes the positions of the sampled elements.
+template <HashCombinatorPolicy Combinator = FNV1aCombinator, RangeSamplingPolicy Sampler = RanluxSampler, std::ranges::forward_range Range>
+constexpr std::size_t GetRangeHash(const Range& range, UInt64 seed)
+{
+	ImpHash::HashCombinator<Combinator> hc(seed);
+	AddRangeSample<Sampler>(hc, range);
 	return hc.Get();
 }
 
 
+// Only these element types hash the same as bytes and as values: equal values have equal bytes, and vice versa.
+template <class Type>
+constexpr bool HashesRangeAsBytes = std::is_integral_v<Type> || std::is_enum_v<Type> || HashesAsBytes<Type>;
+
+
+// All elements. Contiguous ranges of 'HashesRangeAsBytes' elements are hashed as one block of bytes, by 'HashBytes()',
+// other ranges element by element in one pass, then the number of elements.
+template <HashCombinatorPolicy Combinator = FNV1aCombinator, std::ranges::forward_range Range>
+constexpr std::size_t GetFullRangeHash(const Range& range)
+{
+	using Element = std::remove_cvref_t<std::ranges::range_reference_t<const Range&>>;
+
+	if constexpr (std::ranges::contiguous_range<const Range&> && HashesRangeAsBytes<Element>) {
+		const std::span elements(range);
+		return Combinator::Single(HashBytes(std::as_bytes(elements)));
+	} else {
+		ImpHash::HashCombinator<Combinator> hc;
+		UInt64                              size = 0;
+		for (const auto& value : range) {
+			hc.Add(value);
+			size++;
+		}
+
+		hc.AddHash(size);
+		return hc.Get();
+	}
+}
+
+
+}	// namespace ImpHash
+
+
+// === HashSampleWith, HashSample, HashAll =============================================================================
+// The modes of 'BF::HashRange'. 'HashSampleWith<Sampler>' hashes a sample selected by 'Sampler' (see above),
+// 'HashAll' every element.
+
+template <RangeSamplingPolicy SamplerType>
+struct HashSampleWith {
+	using Sampler = SamplerType;
+	explicit HashSampleWith() = default;
+};
+
+
+using HashSample         = HashSampleWith<RanluxSampler>;
+using HashSampleSplitMix = HashSampleWith<SplitMixSampler>;
+using HashSampleStride   = HashSampleWith<StrideSampler>;
+using HashSampleLog      = HashSampleWith<LogSampler>;
+
+
+struct HashAll { explicit HashAll() = default; };
+
+
+namespace ImpHash {
+
+template <class Mode>
+constexpr bool IsHashSampleMode = false;
+
+template <class Sampler>
+constexpr bool IsHashSampleMode<HashSampleWith<Sampler>> = true;
+
 }	// namespace ImpHash
 
 
 // === class HashRange =================================================================================================
 
-template <class Range>
+// 'Mode' is a sampling mode ('HashSample' by default, see above), which hashes a fixed or slowly growing number of
+// elements for any size, e.g. 'BF::HashRange(mRange, BF::HashSampleLog())'. Keys, which differ only in a few elements
+// in the middle, would collide: use 'HashAll' for them, e.g. 'BF::HashRange(mRange, BF::HashAll())'. It hashes every
+// element, a contiguous range of integers in one pass over its bytes (see 'ImpHash::GetFullRangeHash()').
+//
+// 'Range' has to be a forward range, e.g. 'std::list', 'std::set' or a view. Non-random access ranges are walked in one
+// pass, without copying them, see 'ImpHash::AddRangeSample()'.
+
+template <class Range, class Mode = HashSample>
 class HashRange final {
 private:
-	static_assert(std::ranges::random_access_range<std::remove_cvref_t<Range>>, "'Range' must be a random access range.");
+	static_assert(ImpHash::IsHashSampleMode<Mode> || std::is_same_v<Mode, HashAll>, "'Mode' must be a 'HashSampleWith<Sampler>' or 'HashAll'.");
+	static_assert(std::ranges::forward_range<const std::remove_cvref_t<Range>>, "'Range' must be a forward range.");
 	static_assert(IsDecayed<Range> || std::is_array_v<Range>, "'Range' must be a decayed type or a C array.");
 	using RangeElement = std::remove_reference_t<std::ranges::range_reference_t<Range>>;
 	static_assert(IsDecayed<std::remove_const_t<RangeElement>>, "'Range' element type must be a (possibly const) decayed type.");
 
 public:
 	constexpr explicit HashRange(const Range& range) : mRange(range) {}
+	constexpr explicit HashRange(const Range& range, Mode) : mRange(range) {}
 
 private:
 	template <class Type>
 	friend struct std::hash;
 
+	friend class ImpHash::StableHashState;
+
 	const Range& mRange;
 };
 
@@ -111,10 +327,19 @@ private:
 	template <class Type>
 	friend struct std::hash;
 
+	friend class ImpHash::StableHashState;
+
 	const std::span<const std::byte, Size> mSpan;
 };
 
 
+template <class Range>
+HashRange(const Range&) -> HashRange<Range>;
+
+template <class Range, class Mode>
+HashRange(const Range&, Mode) -> HashRange<Range, Mode>;
+
+
 template <class Type>
 HashRawMemory(const Type&) -> HashRawMemory<sizeof(Type)>;
 
@@ -127,11 +352,14 @@ HashRawMemory(Type1, Type2) -> HashRawMemory<std::dynamic_extent>;
 
 // === std::hash specializations =======================================================================================
 
-template <class Range>
-struct std::hash<BF::HashRange<Range>> {
+template <class Range, class Mode>
+struct std::hash<BF::HashRange<Range, Mode>> {
 	[[nodiscard]]
-	constexpr static std::size_t operator()(BF::HashRange<Range> value) {
-		return BF::ImpHash::GetRangeHash(value.mRange);
+	constexpr static std::size_t operator()(BF::HashRange<Range, Mode> value) {
+		if constexpr (std::is_same_v<Mode, BF::HashAll>)
+			return BF::ImpHash::GetFullRangeHash(value.mRange);
+		else
+			return BF::ImpHash::GetRangeHash<BF::FNV1aCombinator, typename Mode::Sampler>(value.mRange);
 	}
 };
 
@@ -140,6 +368,6 @@ template <std::size_t Size>
 struct std::hash<BF::HashRawMemory<Size>> {
 	[[nodiscard]]
 	static std::size_t operator()(BF::HashRawMemory<Size> value) {
-		return BF::ImpHash::GetRangeHash(value.mSpan);
+		return static_cast<std::size_t>(BF::HashBytes(value.mSpan));
 	}
 };
@@ -0,0 +1,89 @@
+// Streaming hashing. Values, ranges and raw bytes are absorbed one by one into a single hash state.
+
+
+#pragma once
+#include <cstring>
+#include <ranges>
+#include <span>
+#include "BF/HashRange.hpp"
+
+
+namespace BF {
+
+
+// === class BasicHashState, HashState =================================================================================
+// Types which are hashed piece by piece can be streamed into a state, instead of computing one 'std::size_t' per
+// sub-object and combining those. A type can receive the state with a 'BF_HashInto()' method:
+//
+//     struct Key {
+//         void BF_HashInto(BF::HashState& state) const { state.Add(mId, mName).AddRange(mParts); }
+//         BF::Hash BF_GetHash() const                  { return BF::HashState().Add(*this).GetHash(); }
+//     };
+//
+// 'Add()' calls 'BF_HashInto()' of the values that have one, thus nested keys are hashed in one pass. Other values
+// are hashed with 'std::hash', like in 'BF::Hash'.
+
+template <HashCombinatorPolicy Combinator>
+class BasicHashState {
+public:
+	constexpr BasicHashState() = default;
+
+	constexpr BasicHashState& Add(const auto&... values) {
+		( ..., AddOne(values) );
+		return *this;
+	}
+
+	template <std::ranges::input_range Range>				// all elements are absorbed, not only samples
+	constexpr BasicHashState& AddRange(Range&& range) {
+		UInt64 size = 0;
+		for (const auto& value : range) {
+			AddOne(value);
+			size++;
+		}
+
+		mHC.AddHash(size);
+		return *this;
+	}
+
+	BasicHashState& AddBytes(std::span<const std::byte> bytes) {
+		const std::byte*  data = bytes.data();
+		const std::size_t size = bytes.size();
+
+		std::size_t i = 0;
+		for (; i + sizeof(UInt64) <= size; i += sizeof(UInt64))
+			mHC.AddHash(LoadWord(data + i, sizeof(UInt64)));
+
+		if (i < size)
+			mHC.AddHash(LoadWord(data + i, size - i));
+
+		mHC.AddHash(size);
+		return *this;
+	}
+
+	constexpr BasicHash<Combinator> GetHash() const {
+		return BasicHash<Combinator>(typename BasicHash<Combinator>::FromValueSelector(), mHC.Get());
+	}
+
+private:
+	template <class Type>
+	constexpr void AddOne(const Type& value) {
+		if constexpr (requires (BasicHashState& state) { value.BF_HashInto(state); })
+			value.BF_HashInto(*this);
+		else
+			mHC.Add(value);
+	}
+
+	static UInt64 LoadWord(const std::byte* source, std::size_t size) {
+		UInt64 word = 0;
+		std::memcpy(&word, source, size);
+		return word;
+	}
+
+	ImpHash::HashCombinator<Combinator> mHC;
+};
+
+
+using HashState = BasicHashState<FNV1aCombinator>;
+
+
+}	// namespace BF
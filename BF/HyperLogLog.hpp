@@ -0,0 +1,82 @@
+// Estimating the number of distinct values in a stream, with a fixed amount of memory.
+
+
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <vector>
+#include "BF/Hash.hpp"
+
+
+namespace BF {
+
+
+// === class HyperLogLog ===============================================================================================
+// 2^Precision one byte registers. The high 'Precision' bits of the (mixed) hash select a register, which keeps the
+// maximum number of leading zeros seen in the remaining bits. The relative standard error is about
+// 1.04 / sqrt(2^Precision), e.g. 0.8% for the default precision, which uses 16 KiB. Small cardinalities are estimated by
+// linear counting of the empty registers.
+//
+// Sketches with the same 'Precision' and 'Hasher' can be merged: the result is the same as if all values had been
+// inserted into one sketch. Merging is an elementwise maximum over the registers, the compiler can vectorize it.
+
+template <class Type, class Hasher = std::hash<Type>, int Precision = 14>
+class HyperLogLog {
+	static_assert(StdHashable<Type> || !std::is_same_v<Hasher, std::hash<Type>>, "'Type' is not hashable.");
+	static_assert(Precision >= 4 && Precision <= 18, "'Precision' must be in [4, 18].");
+
+public:
+	HyperLogLog() :
+		mRegisters(RegisterCount, 0)
+	{
+	}
+
+	void Insert(const Type& value) {
+		const UInt64      hash  = FMix64(static_cast<UInt64>(mHasher(value)));
+		const std::size_t index = static_cast<std::size_t>(hash >> (64 - Precision));
+		const UInt8       rank  = static_cast<UInt8>(std::countl_zero((hash << Precision) | GuardBit) + 1);
+
+		mRegisters[index] = std::max(mRegisters[index], rank);
+	}
+
+	void Merge(const HyperLogLog& other) {
+		UInt8*       registers      = mRegisters.data();
+		const UInt8* otherRegisters = other.mRegisters.data();
+
+		for (std::size_t i = 0; i < RegisterCount; i++)
+			registers[i] = std::max(registers[i], otherRegisters[i]);
+	}
+
+	double Estimate() const {
+		double      sum       = 0;
+		std::size_t zeroCount = 0;
+		for (const UInt8 reg : mRegisters) {
+			sum       += std::ldexp(1.0, -reg);
+			zeroCount += (reg == 0);
+		}
+
+		const double m        = RegisterCount;
+		const double alpha    = 0.7213 / (1 + 1.079 / m);
+		const double estimate = alpha * m * m / sum;
+
+		if (estimate <= 2.5 * m && zeroCount > 0)
+			return m * std::log(m / static_cast<double>(zeroCount));
+
+		return estimate;
+	}
+
+	void Clear() {
+		std::ranges::fill(mRegisters, UInt8(0));
+	}
+
+private:
+	constexpr static std::size_t RegisterCount = std::size_t(1) << Precision;
+	constexpr static UInt64      GuardBit      = UInt64(1) << (Precision - 1);	// the rank is at most 64 - Precision + 1
+
+	std::vector<UInt8> mRegisters;
+	Hasher             mHasher;
+};
+
+
+}	// namespace BF
@@ -0,0 +1,215 @@
+// String interning: every distinct string is stored once, and is referred to by a small handle. Comparing handles is a
+// pointer comparison, and their hash is computed only once, at interning.
+
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "BF/ClassUtils.hpp"
+#include "BF/FlatHashMap.hpp"
+#include "BF/Hash.hpp"
+#include "BF/HashBytes.hpp"
+
+
+namespace BF {
+
+
+// === Implementation details ==========================================================================================
+
+namespace ImpInternPool {
+
+
+// Stored in the arena, followed by the characters and a terminating zero.
+struct Entry {
+	const char* GetData() const { return reinterpret_cast<const char*>(this + 1); }
+
+	std::size_t hash;
+	std::size_t size;
+};
+
+
+// 'BF::HashBytes()' of the characters, which reads 8 bytes at a time.
+inline std::size_t GetStringHash(std::string_view str)
+{
+	return HashBytes(std::as_bytes(std::span(str)));
+}
+
+
+// Bump allocation from large blocks. Entries never move and are never freed individually.
+class Arena : MoveOnlyClass {
+public:
+	void* Allocate(std::size_t size) {
+		size = (size + alignof(Entry) - 1) & ~(alignof(Entry) - 1);
+
+		if (size > mRemaining) {
+			const std::size_t blockSize = std::max(size, BlockSize);
+			mBlocks.push_back(std::make_unique_for_overwrite<std::byte[]>(blockSize));
+			mNext      = mBlocks.back().get();
+			mRemaining = blockSize;
+		}
+
+		void* result = mNext;
+		mNext      += size;
+		mRemaining -= size;
+		return result;
+	}
+
+private:
+	constexpr static std::size_t BlockSize = 64 * 1024;
+
+	static_assert(alignof(Entry) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+	std::vector<std::unique_ptr<std::byte[]>> mBlocks;
+	std::byte*                                mNext      = nullptr;
+	std::size_t                               mRemaining = 0;
+};
+
+
+// The set stores pointers to the entries, they are looked up by the string and its hash.
+struct LookupKey {
+	std::string_view str;
+	std::size_t      hash;
+};
+
+
+struct EntryHasher {
+	using is_transparent = void;
+
+	std::size_t operator()(const Entry* entry) const    { return entry->hash; }
+	std::size_t operator()(const LookupKey& key) const { return key.hash; }
+};
+
+
+struct EntryEqual {
+	using is_transparent = void;
+
+	bool operator()(const Entry* leftOp, const Entry* rightOp) const     { return leftOp == rightOp; }
+	bool operator()(const Entry* leftOp, const LookupKey& rightOp) const {
+		return leftOp->hash == rightOp.hash && std::string_view(leftOp->GetData(), leftOp->size) == rightOp.str;
+	}
+};
+
+
+}	// namespace ImpInternPool
+
+
+// === class InternedString ============================================================================================
+// A trivially copyable handle of an interned string. Valid as long as its 'BF::InternPool' exists. Handles from the same
+// pool are equal iff their strings are equal. A default constructed handle is the empty string, which isn't stored in
+// the pool.
+
+class InternedString {
+public:
+	InternedString() = default;
+
+	std::string_view GetView() const {
+		return mEntry != nullptr ? std::string_view(mEntry->GetData(), mEntry->size) : std::string_view();
+	}
+
+	const char* GetCStr() const {								// zero terminated
+		return mEntry != nullptr ? mEntry->GetData() : "";
+	}
+
+	std::size_t GetSize() const {
+		return mEntry != nullptr ? mEntry->size : 0;
+	}
+
+	Hash BF_GetHash() const {									// 'BF::HashBytes()' of the characters
+		return Hash::FromValue(mEntry != nullptr ? mEntry->hash : ImpInternPool::GetStringHash({}));
+	}
+
+	bool operator==(const InternedString&) const = default;
+
+private:
+	friend class InternPool;
+
+	explicit InternedString(const ImpInternPool::Entry* entry) :
+		mEntry(entry)
+	{
+	}
+
+	const ImpInternPool::Entry* mEntry = nullptr;
+};
+
+
+// === class InternPool ================================================================================================
+// Thread-safe. The pool is split into shards by the high bits of the string hash, each of them has its own lock,
+// hash set and arena. Looking up an already interned string takes a shared lock only.
+
+class InternPool : ImmobileClass {
+public:
+	InternedString Intern(std::string_view str) {
+		if (str.empty())
+			return InternedString();
+
+		const ImpInternPool::LookupKey key   = { str, ImpInternPool::GetStringHash(str) };
+		Shard&                         shard = GetShard(key.hash);
+
+		{
+			std::shared_lock lock(shard.mutex);
+			if (const auto it = shard.entries.Find(key); it != shard.entries.end())
+				return InternedString(*it);
+		}
+
+		std::unique_lock lock(shard.mutex);
+		if (const auto it = shard.entries.Find(key); it != shard.entries.end())		// interned by another thread
+			return InternedString(*it);
+
+		void* const           memory = shard.arena.Allocate(sizeof(ImpInternPool::Entry) + str.size() + 1);
+		ImpInternPool::Entry* entry  = new (memory) ImpInternPool::Entry{ key.hash, str.size() };
+		char*                 data   = reinterpret_cast<char*>(entry + 1);
+		std::memcpy(data, str.data(), str.size());
+		data[str.size()] = '\0';
+
+		shard.entries.Insert(entry);
+		return InternedString(entry);
+	}
+
+	std::optional<InternedString> Find(std::string_view str) const {	// doesn't intern
+		if (str.empty())
+			return InternedString();
+
+		const ImpInternPool::LookupKey key   = { str, ImpInternPool::GetStringHash(str) };
+		const Shard&                   shard = GetShard(key.hash);
+
+		std::shared_lock lock(shard.mutex);
+		const auto it = shard.entries.Find(key);
+		return it != shard.entries.end() ? std::optional(InternedString(*it)) : std::nullopt;
+	}
+
+	std::size_t GetSize() const {								// the number of distinct non-empty strings
+		std::size_t size = 0;
+		for (const Shard& shard : mShards) {
+			std::shared_lock lock(shard.mutex);
+			size += shard.entries.GetSize();
+		}
+
+		return size;
+	}
+
+private:
+	constexpr static int ShardBits = 4;
+
+	struct alignas(std::hardware_destructive_interference_size) Shard {
+		mutable std::shared_mutex                                                                       mutex;
+		FlatHashSet<const ImpInternPool::Entry*, ImpInternPool::EntryHasher, ImpInternPool::EntryEqual> entries;
+		ImpInternPool::Arena                                                                            arena;
+	};
+
+	const Shard& GetShard(std::size_t hash) const { return mShards[FMix64(hash) >> (64 - ShardBits)]; }
+	Shard&       GetShard(std::size_t hash)       { return mShards[FMix64(hash) >> (64 - ShardBits)]; }
+
+	std::array<Shard, std::size_t(1) << ShardBits> mShards;
+};
+
+
+}	// namespace BF
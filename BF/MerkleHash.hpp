@@ -0,0 +1,148 @@
+// A hash of a large mutable buffer, which is updated in O(k log n) time after k elements changed.
+
+
+#pragma once
+#include <algorithm>
+#include <span>
+#include <vector>
+#include "BF/Assert.hpp"
+#include "BF/HashBytes.hpp"
+#include "BF/HashRange.hpp"
+
+
+namespace BF {
+
+
+// === class MerkleHash ================================================================================================
+// The elements are split into blocks of 'blockSize' elements (the last one can be shorter). Every block is hashed as
+// bytes by 'BF::HashBytes()', and the block hashes are combined pairwise, level by level, up to a single hash. The
+// root is that hash combined with the number of elements. After modifying the elements, 'Update()' rehashes only the
+// modified blocks and their ancestors:
+//
+//     std::vector<char> document = Load();
+//     BF::MerkleHash<char> hash(document);
+//     document[12345] = 'x';
+//     hash.Update(document, 12345, 1);			// 1 block and log2(blockCount) nodes instead of the whole document
+//
+// The tree doesn't keep a reference to the elements, they are passed to every call. 'Diff()' compares two trees of
+// the same shape, and returns the indices of the differing blocks, descending only into differing subtrees, e.g. to
+// send only the changed blocks to a replica.
+
+template <class Type>
+class MerkleHash {
+	static_assert(ImpHash::HashesRangeAsBytes<Type>, "'Type' must be hashable as bytes.");
+
+public:
+	constexpr static std::size_t DefaultBlockSize = std::max<std::size_t>(4096 / sizeof(Type), 1);		// 4 KiB
+
+	explicit MerkleHash(std::span<const Type> elements, std::size_t blockSize = DefaultBlockSize) :
+		mElementCount(elements.size()),
+		mBlockSize(blockSize)
+	{
+		BF_ASSERT(blockSize > 0);
+
+		std::size_t nodeCount = (elements.size() + blockSize - 1) / blockSize;
+		do {
+			mLevels.emplace_back(nodeCount);
+			nodeCount = (nodeCount + 1) / 2;
+		} while (mLevels.back().size() > 1);
+
+		Rehash(elements, 0, GetBlockCount());
+	}
+
+	// Rehashes the blocks containing [first, first + count) of 'elements', which has the same size as at construction.
+	void Update(std::span<const Type> elements, std::size_t first, std::size_t count) {
+		BF_ASSERT(elements.size() == mElementCount);
+		BF_ASSERT(first + count <= mElementCount);
+
+		if (count > 0)
+			Rehash(elements, first / mBlockSize, (first + count - 1) / mBlockSize + 1);
+	}
+
+	UInt64 GetRoot() const {
+		ImpHash::HashCombinator<WideMulCombinator> hc;
+		hc.AddHash(mLevels.back().empty() ? 0 : mLevels.back()[0]);
+		hc.AddHash(mElementCount);
+		return hc.Get();
+	}
+
+	UInt64 GetBlockHash(std::size_t block) const {
+		return mLevels[0][block];
+	}
+
+	std::size_t GetBlockCount() const {
+		return mLevels[0].size();
+	}
+
+	std::size_t GetBlockSize() const {
+		return mBlockSize;
+	}
+
+	// Returns the indices of the blocks which differ from the blocks of 'other', in increasing order. 'other' has to
+	// have the same number of elements and block size.
+	std::vector<std::size_t> Diff(const MerkleHash& other) const {
+		BF_ASSERT(mElementCount == other.mElementCount && mBlockSize == other.mBlockSize);
+
+		std::vector<std::size_t> nodes;									// the differing nodes of the current level
+		if (!mLevels.back().empty() && mLevels.back()[0] != other.mLevels.back()[0])
+			nodes.push_back(0);
+
+		for (std::size_t level = mLevels.size() - 1; level > 0 && !nodes.empty(); level--) {
+			const std::vector<UInt64>& children      = mLevels[level - 1];
+			const std::vector<UInt64>& otherChildren = other.mLevels[level - 1];
+
+			std::vector<std::size_t> differingChildren;
+			for (const std::size_t node : nodes) {
+				for (std::size_t child = 2 * node; child < std::min(2 * node + 2, children.size()); child++) {
+					if (children[child] != otherChildren[child])
+						differingChildren.push_back(child);
+				}
+			}
+
+			nodes = std::move(differingChildren);
+		}
+
+		return nodes;
+	}
+
+private:
+	// Rehashes the blocks [begin, end) and their ancestors.
+	void Rehash(std::span<const Type> elements, std::size_t begin, std::size_t end) {
+		for (std::size_t block = begin; block < end; block++) {
+			const std::size_t first = block * mBlockSize;
+			const std::size_t size  = std::min(mBlockSize, mElementCount - first);
+			mLevels[0][block] = HashBytes(std::as_bytes(elements.subspan(first, size)));
+		}
+
+		for (std::size_t level = 1; level < mLevels.size() && begin < end; level++) {	// the parents of [begin, end)
+			const std::vector<UInt64>& children = mLevels[level - 1];
+
+			begin = begin / 2;
+			end   = (end + 1) / 2;
+			for (std::size_t node = begin; node < end; node++) {
+				if (2 * node + 1 < children.size()) {
+					ImpHash::HashCombinator<WideMulCombinator> hc;
+					hc.AddHash(children[2 * node]);
+					hc.AddHash(children[2 * node + 1]);
+					mLevels[level][node] = hc.Get();
+				} else {
+					mLevels[level][node] = children[2 * node];				// a single child is moved up
+				}
+			}
+		}
+	}
+
+	std::size_t                      mElementCount;
+	std::size_t                      mBlockSize;
+	std::vector<std::vector<UInt64>> mLevels;						// from the blocks to the root
+};
+
+
+template <class Range>
+MerkleHash(const Range&) -> MerkleHash<std::remove_cvref_t<std::ranges::range_value_t<Range>>>;
+
+template <class Range>
+MerkleHash(const Range&, std::size_t) -> MerkleHash<std::remove_cvref_t<std::ranges::range_value_t<Range>>>;
+
+
+}	// namespace BF
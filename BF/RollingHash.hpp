@@ -0,0 +1,111 @@
+// A hash of a sliding window, updated in O(1) time when the window moves by one element.
+
+
+#pragma once
+#include <array>
+#include <bit>
+#include "BF/Assert.hpp"
+#include "BF/Hash.hpp"
+
+
+namespace BF {
+
+
+// === Implementation details ==========================================================================================
+
+namespace ImpHash {
+
+
+// Random 64 bit values for the 256 byte values (shared with 'BF::ContentDefinedChunker'). 'FMix64()' is a bijection, so
+// the values are distinct.
+constexpr std::array<UInt64, 256> ByteTable = [] {
+	std::array<UInt64, 256> table;
+	for (std::size_t i = 0; i < table.size(); i++)
+		table[i] = FMix64(i + 1);
+
+	return table;
+}();
+
+
+}	// namespace ImpHash
+
+
+// === class RollingHash ===============================================================================================
+// Buzhash (cyclic polynomial): the hash of the window [i, i + windowSize) is the XOR of the element values, each
+// rotated by its distance from the end of the window. Moving the window is a rotation and two XORs, independent of the
+// window size:
+//
+//     BF::RollingHash hash(windowSize);
+//     for (std::size_t i = 0; i < windowSize; i++)
+//         hash.Add(bytes[i]);
+//
+//     for (std::size_t i = windowSize; i < bytes.size(); i++)
+//         hash.Roll(bytes[i - windowSize], bytes[i]);				// hash of bytes[i - windowSize + 1, i]
+//
+// Byte-sized elements (e.g. 'std::byte', 'char') are looked up in a table, other elements are hashed with 'Hasher'.
+// Equal windows have equal hashes, wherever they are. In windows longer than 64 elements, two equal elements 64
+// positions apart cancel out, so windows of at most 64 elements are recommended.
+
+template <class Type = std::byte, class Hasher = std::hash<Type>>
+class RollingHash {
+	constexpr static bool IsByte = sizeof(Type) == 1 && (std::is_integral_v<Type> || std::is_enum_v<Type>);
+
+	static_assert(IsByte || StdHashable<Type> || !std::is_same_v<Hasher, std::hash<Type>>, "'Type' is not hashable.");
+
+public:
+	constexpr explicit RollingHash(std::size_t windowSize) :
+		mWindowSize(windowSize),
+		mRemovedRotation(static_cast<int>(windowSize % 64))
+	{
+		BF_ASSERT(windowSize > 0);
+	}
+
+	// Appends 'value' to the window, while it isn't full yet.
+	constexpr void Add(const Type& value) {
+		BF_ASSERT(mSize < mWindowSize);							// use 'Roll()' when the window is full
+
+		mHash = std::rotl(mHash, 1) ^ GetValue(value);
+		mSize++;
+	}
+
+	// Appends 'added' to the full window, and removes 'removed', which has to be its first element.
+	constexpr void Roll(const Type& removed, const Type& added) {
+		BF_ASSERT(mSize == mWindowSize);						// use 'Add()' until the window is full
+
+		mHash = std::rotl(mHash, 1) ^ std::rotl(GetValue(removed), mRemovedRotation) ^ GetValue(added);
+	}
+
+	constexpr UInt64 Get() const {
+		return mHash;
+	}
+
+	constexpr std::size_t GetWindowSize() const {
+		return mWindowSize;
+	}
+
+	constexpr bool IsFull() const {
+		return mSize == mWindowSize;
+	}
+
+	constexpr void Clear() {
+		mHash = 0;
+		mSize = 0;
+	}
+
+private:
+	constexpr UInt64 GetValue(const Type& value) const {
+		if constexpr (IsByte)
+			return ImpHash::ByteTable[static_cast<UInt8>(value)];
+		else
+			return FMix64(static_cast<UInt64>(mHasher(value)));
+	}
+
+	UInt64      mHash = 0;
+	std::size_t mSize = 0;
+	std::size_t mWindowSize;
+	int         mRemovedRotation;
+	Hasher      mHasher;
+};
+
+
+}	// namespace BF
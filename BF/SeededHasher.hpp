@@ -0,0 +1,59 @@
+// A hasher with its own seed, for hash containers whose keys may be chosen by an attacker, or are badly structured.
+
+
+#pragma once
+#include <ranges>
+#include "BF/HashRange.hpp"
+
+
+namespace BF {
+
+
+// === class SeededHasher ==============================================================================================
+// The seed is absorbed before the key's 'std::hash' value by 'WideMulCombinator' (see 'BF::Seeded'), which mixes all
+// bits. So keys like IDs with a stride of 2^k are spread over all buckets, and the bucket of a key can't be predicted
+// without knowing the seed. A default constructed hasher uses 'BF::GetProcessHashSeed()'. Pass a different seed to
+// every container (e.g. 'std::unordered_map(bucketCount, SeededHasher<Key>(seed))') to make them independent.
+//
+// Forward ranges without 'std::hash' (e.g. 'std::vector<int>', 'std::list<int>') are hashed like 'BF::HashRange', with
+// the seed also selecting the sampled elements. Note: the seed can't reach inside the 'std::hash' of the key, so keys
+// whose 'std::hash' values collide still collide. For 'BF_GetHash()' types, return 'BF::SeededHash' to seed the
+// members' combination too.
+
+template <class Type, HashCombinatorPolicy Combinator = WideMulCombinator>
+class SeededHasher {
+public:
+	SeededHasher() :
+		mSeed(GetProcessHashSeed())
+	{
+	}
+
+	constexpr explicit SeededHasher(UInt64 seed) :
+		mSeed(seed)
+	{
+	}
+
+	[[nodiscard]]
+	constexpr std::size_t operator()(const Type& value) const {
+		if constexpr (StdHashable<Type>) {
+			ImpHash::HashCombinator<Combinator> hc(mSeed);
+			hc.Add(value);
+			return hc.Get();
+		} else if constexpr (std::ranges::forward_range<const Type>) {
+			return ImpHash::GetRangeHash<Combinator>(value, mSeed);
+		} else {
+			static_assert(false, "'Type' is not hashable.");
+			return 0;
+		}
+	}
+
+	constexpr UInt64 GetSeed() const {
+		return mSeed;
+	}
+
+private:
+	UInt64 mSeed;
+};
+
+
+}	// namespace BF
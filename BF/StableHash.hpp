@@ -0,0 +1,308 @@
+// Hash values, which are the same in every process, build and platform. E.g. for hash indexes stored in files, which
+// are memory-mapped and probed by another process, without rehashing the keys at startup.
+
+
+#pragma once
+#include <bit>
+#include <cstring>
+#include <string_view>
+#include "BF/BasicMath.hpp"
+#include "BF/HashRange.hpp"
+
+
+namespace BF {
+
+
+class StableHash;
+
+
+// === Implementation details ==========================================================================================
+
+// Frozen copies of 'BF::WideMulCombinator' and 'BF::ImpHash::BytesHasher', as they were when the format was fixed. The
+// originals are tuned for speed and can change, these never do: every stored 'BF::StableHash' depends on them.
+namespace ImpStableHash {
+
+
+class Combinator {
+public:
+	constexpr void Add(UInt64 newHash) {
+		if (mCount % 2 == 0)
+			mPending = newHash;
+		else
+			mHash = Mix(mPending ^ mHash ^ Secret1, newHash ^ mHash ^ Secret2);
+
+		mCount++;
+	}
+
+	constexpr UInt64 Get() const {
+		UInt64 hash = mHash;
+		if (mCount % 2 != 0)
+			hash = Mix(mPending ^ mHash ^ Secret1, mHash ^ Secret3);
+
+		return Mix(hash ^ Secret3, mCount ^ Secret0);
+	}
+
+private:
+	constexpr static UInt64 Mix(UInt64 a, UInt64 b) {
+		return a ^ b ^ UMul128Fold(a, b);
+	}
+
+	constexpr static UInt64 Secret0 = 0xa0761d6478bd642f;
+	constexpr static UInt64 Secret1 = 0xe7037ed1a0b428db;
+	constexpr static UInt64 Secret2 = 0x8ebc6af09c88c6e3;
+	constexpr static UInt64 Secret3 = 0x589965cc75374cc3;
+
+	UInt64 mHash    = Secret0;
+	UInt64 mPending = 0;
+	UInt64 mCount   = 0;
+};
+
+
+// wyhash (final version 4). The loads are little endian on every platform.
+class BytesHasher {
+public:
+	static UInt64 Hash(const std::byte* data, std::size_t size, UInt64 seed) {
+		seed ^= UMul128Fold(seed ^ Secret0, Secret1);
+
+		UInt64 a = 0;
+		UInt64 b = 0;
+
+		if (size <= 16) {
+			if (size >= 4) {
+				const std::size_t shift = (size >> 3) << 2;
+				a = (Read4(data) << 32) | Read4(data + shift);
+				b = (Read4(data + size - 4) << 32) | Read4(data + size - 4 - shift);
+			} else if (size > 0) {
+				a = (UInt64(data[0]) << 16) | (UInt64(data[size >> 1]) << 8) | UInt64(data[size - 1]);
+			}
+		} else {
+			const std::byte* p         = data;
+			std::size_t      remaining = size;
+
+			if (remaining > 48) {
+				UInt64 seed1 = seed;
+				UInt64 seed2 = seed;
+
+				do {
+					seed  = UMul128Fold(Read8(p)      ^ Secret1, Read8(p + 8)  ^ seed);
+					seed1 = UMul128Fold(Read8(p + 16) ^ Secret2, Read8(p + 24) ^ seed1);
+					seed2 = UMul128Fold(Read8(p + 32) ^ Secret3, Read8(p + 40) ^ seed2);
+					p         += 48;
+					remaining -= 48;
+				} while (remaining > 48);
+
+				seed ^= seed1 ^ seed2;
+			}
+
+			while (remaining > 16) {
+				seed = UMul128Fold(Read8(p) ^ Secret1, Read8(p + 8) ^ seed);
+				p         += 16;
+				remaining -= 16;
+			}
+
+			a = Read8(p + remaining - 16);
+			b = Read8(p + remaining - 8);
+		}
+
+		a ^= Secret1;
+		b ^= seed;
+		a  = UMul128(a, b, b);
+
+		return UMul128Fold(a ^ Secret0 ^ size, b ^ Secret1);
+	}
+
+private:
+	static UInt64 Read8(const std::byte* p) {
+		UInt64 value;
+		std::memcpy(&value, p, sizeof(value));
+		if constexpr (std::endian::native == std::endian::big)
+			value = std::byteswap(value);
+
+		return value;
+	}
+
+	static UInt64 Read4(const std::byte* p) {
+		UInt32 value;
+		std::memcpy(&value, p, sizeof(value));
+		if constexpr (std::endian::native == std::endian::big)
+			value = std::byteswap(value);
+
+		return value;
+	}
+
+	constexpr static UInt64 Secret0 = 0x2d358dccaa6c78a5;
+	constexpr static UInt64 Secret1 = 0x8bb84b93962eacc9;
+	constexpr static UInt64 Secret2 = 0x4b33a62ed433d4a3;
+	constexpr static UInt64 Secret3 = 0x4d5a2da51de1aa47;
+};
+
+
+}	// namespace ImpStableHash
+
+
+namespace ImpHash {
+
+
+template <class Type>
+constexpr bool IsHashRange = false;
+
+template <class Range, class Mode>
+constexpr bool IsHashRange<HashRange<Range, Mode>> = true;
+
+
+template <class Type>
+struct RangeModeOf;
+
+template <class Range, class Mode>
+struct RangeModeOf<HashRange<Range, Mode>> : std::type_identity<Mode> {};
+
+
+template <class Type>
+constexpr bool IsHashAllRange = false;
+
+template <class Range>
+constexpr bool IsHashAllRange<HashRange<Range, HashAll>> = true;
+
+
+template <class Type>
+constexpr bool IsHashRawMemory = false;
+
+template <std::size_t Size>
+constexpr bool IsHashRawMemory<HashRawMemory<Size>> = true;
+
+
+// Every value is turned into 64 bit words by a fixed rule, and the words are combined by 'ImpStableHash::Combinator',
+// which is fully specified by its constants. Nothing depends on 'std::hash' or on the byte order.
+class StableHashState {
+public:
+	constexpr explicit StableHashState(UInt64 seed) :
+		mSeed(seed)
+	{
+		mCombinator.Add(seed);
+	}
+
+	constexpr void Add(const auto&... values) {
+		( ..., AddOne(values) );
+	}
+
+	constexpr UInt64 Get() const {
+		return mCombinator.Get();
+	}
+
+private:
+	template <class Type>
+	constexpr void AddOne(const Type& value);
+
+	void AddBytes(const std::byte* data, std::size_t size) {		// the size is hashed by 'BytesHasher'
+		mCombinator.Add(ImpStableHash::BytesHasher::Hash(data, size, mSeed));
+	}
+
+	ImpStableHash::Combinator mCombinator;
+	UInt64                    mSeed;
+};
+
+
+}	// namespace ImpHash
+
+
+// === class StableHash ================================================================================================
+// Like 'BF::Hash', constructed from the values to hash, but with an explicit seed first. Supported values:
+//   - Integral and enum values: their numeric value, so e.g. 'Int32(-1)' and 'Int64(-1)' hash the same.
+//   - Strings (anything convertible to 'std::string_view'): their characters and their size.
+//   - 'BF::StableHash': its value.
+//   - 'BF::HashRange': the same elements as its 'std::hash' (a sample, or all of them with 'BF::HashAll'), each
+//     element hashed by these rules.
+//   - 'BF::HashRawMemory': all bytes, in one pass.
+//
+// The algorithm is part of the interface: changing it would invalidate every stored index, so it never changes. Only
+// the values of 'BF::HashRawMemory' (e.g. of a struct of integers) depend on the byte order of the platform; the bytes
+// themselves are read in little endian order.
+
+class StableHash final {
+public:
+	constexpr explicit StableHash(UInt64 seed, const auto&... values) {
+		ImpHash::StableHashState state(seed);
+		state.Add(values...);
+		mValue = state.Get();
+	}
+
+	constexpr UInt64 GetValue() const {
+		return mValue;
+	}
+
+	constexpr bool operator==(const StableHash&) const = default;
+
+private:
+	UInt64 mValue;
+};
+
+
+// === class StableHasher ==============================================================================================
+// A 'Hasher' for containers and filters (e.g. 'BF::FlatHashMap', 'BF::BloomFilter'), whose contents are persisted.
+// Transparent: 'std::string' and 'std::string_view' keys hash the same.
+
+template <UInt64 Seed = 0>
+struct StableHasher {
+	using is_transparent = void;
+
+	[[nodiscard]]
+	constexpr static std::size_t operator()(const auto& value) {
+		return static_cast<std::size_t>(StableHash(Seed, value).GetValue());
+	}
+};
+
+
+// === Implementation details ==========================================================================================
+
+namespace ImpHash {
+
+
+template <class Type>
+constexpr void StableHashState::AddOne(const Type& value)
+{
+	if constexpr (std::is_same_v<Type, StableHash>) {
+		mCombinator.Add(value.GetValue());
+	} else if constexpr (std::is_integral_v<Type> || std::is_enum_v<Type>) {
+		static_assert(sizeof(Type) <= sizeof(UInt64), "'Type' is too large.");
+		mCombinator.Add(static_cast<UInt64>(value));
+	} else if constexpr (std::is_convertible_v<const Type&, std::string_view>) {
+		const std::string_view str = value;
+		AddBytes(reinterpret_cast<const std::byte*>(str.data()), str.size());
+	} else if constexpr (IsHashRange<Type>) {
+		StableHashState rangeState(mSeed);							// the range is one value, like in 'BF::Hash'
+		if constexpr (IsHashAllRange<Type>) {
+			UInt64 size = 0;
+			for (const auto& element : value.mRange) {
+				rangeState.Add(element);
+				size++;
+			}
+
+			rangeState.Add(size);
+		} else {
+			AddRangeSample<typename RangeModeOf<Type>::type::Sampler>(rangeState, value.mRange);
+		}
+
+		mCombinator.Add(rangeState.Get());
+	} else if constexpr (IsHashRawMemory<Type>) {
+		AddBytes(value.mSpan.data(), value.mSpan.size());
+	} else {
+		static_assert(false, "'Type' is not stable hashable.");
+	}
+}
+
+
+}	// namespace ImpHash
+
+
+}	// namespace BF
+
+
+// === std::hash specializations =======================================================================================
+
+template <>
+struct std::hash<BF::StableHash> {
+	[[nodiscard]]
+	constexpr static std::size_t operator()(const BF::StableHash& value) {
+		return static_cast<std::size_t>(value.GetValue());
+	}
+};
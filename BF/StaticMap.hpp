@@ -0,0 +1,235 @@
+// A read-only map with a fixed key set, which is known at compile time. Lookups use a perfect hash function, which is
+// found at construction.
+
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <exception>
+#include <span>
+#include <string_view>
+#include <utility>
+#include "BF/Assert.hpp"
+#include "BF/Hash.hpp"
+
+
+namespace BF {
+
+
+// === Implementation details ==========================================================================================
+
+namespace ImpStaticMap {
+
+
+// 'std::hash' is not 'constexpr' for fundamental types and strings, so integral and string-like keys are hashed here.
+// Other keys are hashed with 'std::hash', which has to be 'constexpr' for compile time construction (e.g., a
+// 'constexpr' 'BF_GetHash()').
+template <class Key>
+constexpr UInt64 GetKeyHash(const Key& key, UInt64 seed)
+{
+	if constexpr (std::is_integral_v<Key> || std::is_enum_v<Key>) {
+		return FMix64(static_cast<UInt64>(key) ^ seed);
+	} else if constexpr (std::is_convertible_v<const Key&, std::string_view>) {
+		const std::string_view str = key;
+
+		FNV1aCombinator combinator;
+		combinator.Add(seed);
+		for (const char c : str)
+			combinator.Add(static_cast<UChar>(c));
+		combinator.Add(str.size());
+
+		return FMix64(combinator.Get());
+	} else {
+		static_assert(StdHashable<Key>, "'Key' is not hashable.");
+		return FMix64(std::hash<Key>()(key) ^ seed);
+	}
+}
+
+
+// Called if no perfect hash function was found, which means duplicate keys. Not 'constexpr', so the construction of a
+// 'constexpr' map fails to compile. At run time the program is terminated, even without asserts, instead of leaving a
+// half built map, which would return wrong results.
+[[noreturn]] inline void BuildFailed()
+{
+	BF_BREAK();
+	std::terminate();
+}
+
+
+}	// namespace ImpStaticMap
+
+
+// === class StaticMap =================================================================================================
+// Hash and displace: the keys are distributed into buckets by the high bits of their hash. Then, starting from the
+// largest bucket, a 'pilot' value is searched for every bucket, which sends all of its keys to free slots. A lookup
+// is a single probe: hash, pilot, slot, one key comparison. No heap allocation, everything is stored inline.
+// Construction is 'constexpr'. For large key sets the compiler's constexpr step limit may need to be raised. Duplicate
+// keys are a compilation error for a 'constexpr' map, and terminate the program at run time.
+
+template <class Key, class Value, std::size_t N>
+class StaticMap {
+public:
+	static_assert(N > 0, "'N' must be positive.");
+	static_assert(N < MaxUInt32, "Too many entries.");
+
+	using Entry = std::pair<Key, Value>;
+
+	constexpr explicit StaticMap(const Entry (&entries)[N]) :
+		mEntries(std::to_array(entries))
+	{
+		Build();
+	}
+
+	constexpr explicit StaticMap(const std::array<Entry, N>& entries) :
+		mEntries(entries)
+	{
+		Build();
+	}
+
+	constexpr const Value* Find(const Key& key) const {
+		const UInt64 hash  = ImpStaticMap::GetKeyHash(key, mSeed);
+		const UInt32 index = mSlots[GetSlot(hash, mPilots[GetBucket(hash)])];
+		const Entry& entry = mEntries[index];
+
+		return entry.first == key ? &entry.second : nullptr;
+	}
+
+	constexpr bool Contains(const Key& key) const {
+		return Find(key) != nullptr;
+	}
+
+	constexpr std::size_t GetSize() const {
+		return N;
+	}
+
+	constexpr auto begin() const { return mEntries.begin(); }
+	constexpr auto end()   const { return mEntries.end(); }
+
+private:
+	constexpr static std::size_t BucketCount = (std::bit_ceil(N) + 1) / 2;		// ~2 keys per bucket
+	constexpr static std::size_t SlotCount   = std::bit_ceil(N) * 2;			// load factor is at most 0.5
+	constexpr static UInt32      MaxPilot    = 1 << 16;
+	constexpr static UInt32      MaxAttempts = 64;
+
+	constexpr static UInt64 GetBucket(UInt64 hash) {
+		UInt64 bucket = 0;
+		UMul128(hash, BucketCount, bucket);
+		return bucket;
+	}
+
+	constexpr static UInt64 GetSlot(UInt64 hash, UInt32 pilot) {
+		return FMix64(hash + pilot * 0x9e3779b97f4a7c15) & (SlotCount - 1);
+	}
+
+	constexpr void Build() {
+		for (UInt32 attempt = 0; attempt < MaxAttempts; attempt++) {
+			mSeed = FMix64(attempt + 1);
+			if (TryBuild())
+				return;
+		}
+
+		ImpStaticMap::BuildFailed();		// unreachable, unless there are duplicate keys
+	}
+
+	constexpr bool TryBuild() {
+		std::array<UInt64, N> hashes{};
+		for (std::size_t i = 0; i < N; i++)
+			hashes[i] = ImpStaticMap::GetKeyHash(mEntries[i].first, mSeed);
+
+		std::array<UInt32, BucketCount + 1> bucketStarts{};		// counting sort of the entries by bucket
+		for (std::size_t i = 0; i < N; i++)
+			bucketStarts[GetBucket(hashes[i]) + 1]++;
+		for (std::size_t b = 0; b < BucketCount; b++)
+			bucketStarts[b + 1] += bucketStarts[b];
+
+		std::array<UInt32, N>           entriesByBucket{};
+		std::array<UInt32, BucketCount> fill{};
+		for (UInt32 i = 0; i < N; i++) {
+			const UInt64 bucket = GetBucket(hashes[i]);
+			entriesByBucket[bucketStarts[bucket] + fill[bucket]++] = i;
+		}
+
+		const auto getBucketSize = [&](UInt32 b) { return bucketStarts[b + 1] - bucketStarts[b]; };
+
+		std::array<UInt32, BucketCount> bucketOrder{};
+		for (UInt32 b = 0; b < BucketCount; b++)
+			bucketOrder[b] = b;
+		std::ranges::sort(bucketOrder, [&](UInt32 b1, UInt32 b2) {		// largest first, deterministic order
+			return getBucketSize(b1) != getBucketSize(b2) ? getBucketSize(b1) > getBucketSize(b2) : b1 < b2;
+		});
+
+		std::array<bool, SlotCount> taken{};
+		mSlots.fill(0);													// an empty slot points to any entry, the key comparison will fail
+		mPilots.fill(0);
+
+		for (const UInt32 bucket : bucketOrder) {
+			const UInt32 begin = bucketStarts[bucket];
+			const UInt32 end   = bucketStarts[bucket + 1];
+			if (begin == end)
+				break;
+
+			for (UInt32 i = begin; i < end; i++) {
+				for (UInt32 j = begin; j < i; j++) {
+					if (hashes[entriesByBucket[i]] == hashes[entriesByBucket[j]]) {
+						if (mEntries[entriesByBucket[i]].first == mEntries[entriesByBucket[j]].first)
+							ImpStaticMap::BuildFailed();				// duplicate key, every seed would fail
+
+						return false;									// 64 bit collision, try another seed
+					}
+				}
+			}
+
+			const std::span<const UInt32> bucketEntries(entriesByBucket.data() + begin, end - begin);
+
+			UInt32 pilot = 0;
+			while (pilot < MaxPilot && !TryPilot(pilot, hashes, bucketEntries, taken))
+				pilot++;
+
+			if (pilot == MaxPilot)
+				return false;
+
+			mPilots[bucket] = pilot;
+			for (const UInt32 entry : bucketEntries) {
+				const UInt64 slot = GetSlot(hashes[entry], pilot);
+				taken[slot]  = true;
+				mSlots[slot] = entry;
+			}
+		}
+
+		return true;
+	}
+
+	constexpr static bool TryPilot(UInt32 pilot, const auto& hashes, std::span<const UInt32> bucketEntries, const auto& taken) {
+		for (std::size_t i = 0; i < bucketEntries.size(); i++) {
+			const UInt64 slot = GetSlot(hashes[bucketEntries[i]], pilot);
+			if (taken[slot])
+				return false;
+
+			for (std::size_t j = 0; j < i; j++) {
+				if (GetSlot(hashes[bucketEntries[j]], pilot) == slot)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	std::array<Entry, N>              mEntries;
+	std::array<UInt32, SlotCount>     mSlots{};
+	std::array<UInt32, BucketCount>   mPilots{};
+	UInt64                            mSeed = 0;
+};
+
+
+// === MakeStaticMap() =================================================================================================
+// Deduces 'N'. Usage: constexpr auto map = BF::MakeStaticMap<std::string_view, int>({ { "one", 1 }, { "two", 2 } });
+
+template <class Key, class Value, std::size_t N>
+constexpr StaticMap<Key, Value, N> MakeStaticMap(const std::pair<Key, Value> (&entries)[N])
+{
+	return StaticMap<Key, Value, N>(entries);
+}
+
+
+}	// namespace BF
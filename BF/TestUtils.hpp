@@ -2,8 +2,11 @@
 
 
 #pragma once
+#include <cstddef>
 #include <new>
+#include <random>
 #include <type_traits>
+#include <vector>
 #include "BF/ClassUtils.hpp"
 #include "BF/RawMemory.hpp"
 
@@ -100,4 +103,18 @@ void AssertTrivialCopyMoveDtor()
 }
 
 
+// === MakeRandomBytes() ===============================================================================================
+// 'size' pseudo-random bytes, each less than 'valueCount'. The same bytes for the same 'seed'.
+
+inline std::vector<std::byte> MakeRandomBytes(std::size_t size, UInt64 seed, unsigned valueCount = 256)
+{
+	std::mt19937_64        random(seed);
+	std::vector<std::byte> bytes(size);
+	for (std::byte& byte : bytes)
+		byte = static_cast<std::byte>(random() % valueCount);
+
+	return bytes;
+}
+
+
 }	// namespace BF
@@ -0,0 +1,131 @@
+#include "BF/TreeHash.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+
+namespace BF {
+
+
+namespace {
+
+
+// The helper threads of 'ImpHash::RunParallel()'. They are created on demand, and shared by all calls. A call posts its
+// job, idle workers join it, and the calling thread works on it too. So a call never waits for a worker to become free,
+// and concurrent or nested calls can't deadlock.
+class WorkerPool {
+public:
+	struct Job {
+		std::size_t                           taskCount;
+		FunctionRef<void (std::size_t) const> task;
+		std::size_t                           freeSlots;			// how many more workers can join
+		std::size_t                           workerCount = 0;		// how many are working on it
+		std::atomic<std::size_t>              next        = 0;
+		std::condition_variable               finished;
+	};
+
+	static WorkerPool& Get() {
+		static WorkerPool& pool = *new WorkerPool();				// never destroyed, joining at exit can deadlock
+		return pool;
+	}
+
+	static void Work(Job& job) {
+		for (std::size_t i = job.next++; i < job.taskCount; i = job.next++)
+			job.task(i);
+	}
+
+	void Run(Job& job) {
+		const std::size_t helperCount = job.freeSlots;
+		{
+			std::lock_guard lock(mMutex);
+			for (; mThreadCount < helperCount; mThreadCount++)
+				std::thread([this] { WorkerLoop(); }).detach();
+
+			mJobs.push_back(&job);
+		}
+
+		for (std::size_t i = 0; i < helperCount; i++)
+			mJobPosted.notify_one();
+
+		try {
+			Work(job);
+		} catch (...) {
+			Withdraw(job);
+			throw;
+		}
+
+		Withdraw(job);
+	}
+
+private:
+	void WorkerLoop() {
+		std::unique_lock lock(mMutex);
+		while (true) {
+			mJobPosted.wait(lock, [this] { return !mJobs.empty(); });
+
+			Job& job = *mJobs.front();
+			if (--job.freeSlots == 0)
+				mJobs.pop_front();
+
+			job.workerCount++;
+			lock.unlock();
+			Work(job);
+			lock.lock();
+
+			if (--job.workerCount == 0)
+				job.finished.notify_all();
+		}
+	}
+
+	void Withdraw(Job& job) {										// no more workers join, and waits for the others
+		std::unique_lock lock(mMutex);
+		std::erase(mJobs, &job);
+		job.finished.wait(lock, [&job] { return job.workerCount == 0; });
+	}
+
+	std::mutex              mMutex;
+	std::condition_variable mJobPosted;
+	std::deque<Job*>        mJobs;
+	std::size_t             mThreadCount = 0;
+};
+
+
+}	// namespace
+
+
+void ImpHash::RunParallel(std::size_t taskCount, unsigned threadCount, FunctionRef<void (std::size_t) const> task)
+{
+	if (threadCount == 0)
+		threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+	const std::size_t helperCount = std::min<std::size_t>(threadCount, taskCount) - (taskCount > 0);
+
+	WorkerPool::Job job = { .taskCount = taskCount, .task = task, .freeSlots = helperCount };
+	if (helperCount == 0)
+		WorkerPool::Work(job);
+	else
+		WorkerPool::Get().Run(job);
+}
+
+
+UInt64 TreeHash(std::span<const std::byte> bytes, unsigned threadCount)
+{
+	using ImpHash::TreeLeafSize;
+
+	const std::size_t leafCount = (bytes.size() + TreeLeafSize - 1) / TreeLeafSize;
+
+	std::vector<UInt64> leafHashes(leafCount);
+	ImpHash::RunParallel(leafCount, threadCount, [&](std::size_t leaf) {
+		const std::size_t begin = leaf * TreeLeafSize;
+		leafHashes[leaf] = HashBytes(bytes.subspan(begin, std::min(TreeLeafSize, bytes.size() - begin)));
+	});
+
+	return ImpHash::CombineTreeLeaves(leafHashes, bytes.size());
+}
+
+
+}	// namespace BF
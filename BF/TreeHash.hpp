@@ -0,0 +1,91 @@
+// Hashing very large buffers and ranges on multiple threads.
+
+
+#pragma once
+#include <ranges>
+#include <span>
+#include <vector>
+#include "BF/FunctionRef.hpp"
+#include "BF/HashBytes.hpp"
+#include "BF/HashRange.hpp"
+
+
+namespace BF {
+
+
+// === Implementation details ==========================================================================================
+
+namespace ImpHash {
+
+
+constexpr std::size_t TreeLeafSize         = std::size_t(256) << 10;	// bytes, fits into the L2 cache
+constexpr std::size_t TreeLeafElementCount = std::size_t(16) << 10;		// for ranges, which are not hashed as bytes
+
+
+// Calls 'task(i)' for every 'i' in [0, taskCount), on at most 'threadCount' threads (the calling thread is one).
+// The tasks are taken in order from a shared counter, so a slow thread doesn't hold up the others. 0 'threadCount'
+// means 'std::thread::hardware_concurrency()'. The other threads come from a process-wide pool, which is created at the
+// first call, and grows to the largest 'threadCount' requested. Idle workers join a call, so a busy pool means fewer
+// threads, but no waiting.
+void RunParallel(std::size_t taskCount, unsigned threadCount, FunctionRef<void (std::size_t) const> task);
+
+
+// The root of the tree: the leaf hashes in order, then the total size.
+constexpr UInt64 CombineTreeLeaves(std::span<const UInt64> leafHashes, UInt64 size)
+{
+	HashCombinator<WideMulCombinator> hc;
+	for (const UInt64 leafHash : leafHashes)
+		hc.AddHash(leafHash);
+
+	hc.AddHash(size);
+	return hc.Get();
+}
+
+
+}	// namespace ImpHash
+
+
+// === TreeHash() ======================================================================================================
+// Splits the data into fixed size leaves (256 KiB, or 16 Ki elements), hashes the leaves on 'threadCount' threads, and
+// combines the leaf hashes in order. The leaves don't depend on the number of threads, so neither does the result: it
+// is the same for 1 thread and for 64. Throughput grows with the threads until the memory bandwidth is saturated.
+//
+// Bytes, and contiguous ranges of integers, enums and 'BF_HashAsBytes' types, are hashed by 'BF::HashBytes()', other
+// random access ranges element by element, all elements. The result is different from 'BF::HashBytes()' of the same
+// bytes. Like that, it doesn't depend on the build or the CPU, but it can change between versions of this library.
+// The threads are reused, but handing out the leaves still costs a few microseconds, so use it for large data (e.g.
+// from a few MiB).
+
+UInt64 TreeHash(std::span<const std::byte> bytes, unsigned threadCount = 0);
+
+
+template <std::ranges::random_access_range Range>
+UInt64 TreeHash(const Range& range, unsigned threadCount = 0)
+{
+	using Element = std::remove_cvref_t<std::ranges::range_reference_t<const Range&>>;
+
+	if constexpr (std::ranges::contiguous_range<const Range&> && ImpHash::HashesRangeAsBytes<Element>) {
+		const std::span<const std::byte> bytes = std::as_bytes(std::span(range));	// a static extent would recurse
+		return TreeHash(bytes, threadCount);
+	} else {
+		const std::size_t size      = std::ranges::size(range);
+		const std::size_t leafCount = (size + ImpHash::TreeLeafElementCount - 1) / ImpHash::TreeLeafElementCount;
+
+		std::vector<UInt64> leafHashes(leafCount);
+		ImpHash::RunParallel(leafCount, threadCount, [&](std::size_t leaf) {
+			const std::size_t begin = leaf * ImpHash::TreeLeafElementCount;
+			const std::size_t end   = std::min(begin + ImpHash::TreeLeafElementCount, size);
+
+			ImpHash::HashCombinator<WideMulCombinator> hc;
+			for (std::size_t i = begin; i < end; i++)
+				hc.Add(std::ranges::begin(range)[i]);
+
+			leafHashes[leaf] = hc.Get();
+		});
+
+		return ImpHash::CombineTreeLeaves(leafHashes, size);
+	}
+}
+
+
+}	// namespace BF
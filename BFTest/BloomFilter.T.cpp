@@ -0,0 +1,98 @@
+#include "BF/BloomFilter.hpp"
+
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+struct UserId {
+	BF::Hash BF_GetHash() const { return { mId }; }
+	UInt64 mId;
+};
+
+
+TEST(BloomFilter, Usage)
+{
+	BF::BloomFilter<UserId> filter(1000, 0.01);
+	filter.Insert({ 7 });
+
+	EXPECT_TRUE(filter.MayContain({ 7 }));
+}
+
+
+// === class BloomFilter ===============================================================================================
+
+double GetFalsePositiveRate(const BF::BloomFilter<UInt64>& filter, UInt64 firstAbsent, UInt64 count)
+{
+	std::size_t falsePositives = 0;
+	for (UInt64 i = firstAbsent; i < firstAbsent + count; i++)
+		falsePositives += filter.MayContain(i);
+
+	return static_cast<double>(falsePositives) / static_cast<double>(count);
+}
+
+
+TEST(BloomFilter, FalsePositiveRate)
+{
+	for (const double rate : { 0.1, 0.01, 0.001 }) {
+		BF::BloomFilter<UInt64> filter(100'000, rate);
+
+		for (UInt64 i = 0; i < 100'000; i++)
+			filter.Insert(i);
+
+		for (UInt64 i = 0; i < 100'000; i++)
+			ASSERT_TRUE(filter.MayContain(i));					// no false negatives
+
+		EXPECT_LT(GetFalsePositiveRate(filter, 1'000'000, 100'000), rate * 1.5);
+	}
+}
+
+
+TEST(BloomFilter, Bulk)
+{
+	std::vector<UInt64> keys(1000);
+	std::iota(keys.begin(), keys.end(), 0);
+
+	BF::BloomFilter<UInt64> bulk  (keys.size(), 0.01);
+	BF::BloomFilter<UInt64> single(keys.size(), 0.01);
+
+	bulk.InsertMany(keys);
+	for (const UInt64 key : keys)
+		single.Insert(key);
+
+	EXPECT_TRUE(std::ranges::equal(bulk.GetBytes(), single.GetBytes()));
+
+	std::vector<UInt64> queries(keys.size() * 2);
+	std::iota(queries.begin(), queries.end(), 0);
+
+	std::unique_ptr<bool[]> results(new bool[queries.size()]);
+	bulk.MayContainMany(queries, std::span(results.get(), queries.size()));
+
+	for (std::size_t i = 0; i < queries.size(); i++)
+		EXPECT_EQ(results[i], single.MayContain(queries[i]));
+}
+
+
+TEST(BloomFilter, Serialization)
+{
+	BF::BloomFilter<std::string> filter(100, 0.01);
+	filter.Insert("alpha");
+	filter.Insert("beta");
+
+	const std::vector<std::byte>       bytes(filter.GetBytes().begin(), filter.GetBytes().end());
+	const BF::BloomFilter<std::string> copy(bytes, filter.GetProbeCount());
+
+	EXPECT_TRUE(copy.MayContain("alpha"));
+	EXPECT_TRUE(copy.MayContain("beta"));
+	EXPECT_TRUE(std::ranges::equal(copy.GetBytes(), filter.GetBytes()));
+}
+
+
+}	// namespace
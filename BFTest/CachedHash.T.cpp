@@ -0,0 +1,149 @@
+#include "BF/CachedHash.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BF/HashRange.hpp"
+#include "BF/SeededHasher.hpp"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+using Path = std::vector<std::string>;
+
+
+struct PathHasher {
+	std::size_t operator()(const Path& path) const { return std::hash<BF::HashRange<Path>>()(BF::HashRange(path)); }
+};
+
+
+TEST(CachedHash, Usage)
+{
+	using Key = BF::CachedHash<Path, PathHasher>;
+
+	std::unordered_map<Key, int> sizes;
+	const Key key = Path{ "usr", "local", "bin" };		// hashed once, here
+
+	sizes[key] = 3;
+	EXPECT_EQ(sizes.at(key), 3);
+	EXPECT_EQ(key->size(), 3u);
+}
+
+
+// === class CachedHash ================================================================================================
+
+int hashCount = 0;
+
+
+struct Counted {
+	bool operator==(const Counted&) const = default;
+	BF::Hash BF_GetHash() const { hashCount++; return { value }; }
+	int value;
+};
+
+
+struct OtherKey {
+	BF::Hash BF_GetHash() const { return { key, 1 }; }
+	BF::CachedHash<Counted> key;
+};
+
+
+TEST(CachedHash, HashedOnce)
+{
+	hashCount = 0;
+
+	std::unordered_set<BF::CachedHash<Counted>> set;
+	for (int i = 0; i < 1000; i++)
+		set.insert(Counted{ i });										// rehashes many times
+
+	EXPECT_EQ(hashCount, 1000);
+
+	const BF::CachedHash<Counted> key(std::in_place, 5);
+	EXPECT_EQ(hashCount, 1001);
+	for (int i = 0; i < 10; i++)
+		EXPECT_TRUE(set.contains(key));
+
+	EXPECT_EQ(hashCount, 1001);
+}
+
+
+TEST(CachedHash, SameHashAsValue)
+{
+	const BF::CachedHash<Counted> cached(Counted{ 42 });
+
+	EXPECT_EQ(std::hash<BF::CachedHash<Counted>>()(cached), std::hash<Counted>()(Counted{ 42 }));
+	EXPECT_EQ(cached.GetHashValue(), std::hash<Counted>()(Counted{ 42 }));
+	EXPECT_EQ(std::hash<OtherKey>()({ cached }), std::hash<BF::Hash>()(BF::Hash(Counted{ 42 }, 1)));
+}
+
+
+TEST(CachedHash, Equality)
+{
+	const BF::CachedHash<std::string> a("a");
+	const BF::CachedHash<std::string> a2(std::string("a"));
+	const BF::CachedHash<std::string> b("b");
+
+	EXPECT_EQ(a, a2);
+	EXPECT_NE(a, b);
+}
+
+
+TEST(CachedHash, Modify)
+{
+	BF::CachedHash<std::string> value("a");
+	value.Modify([](std::string& str) { str += "b"; });
+
+	EXPECT_EQ(value.Get(), "ab");
+	EXPECT_EQ(value.GetHashValue(), std::hash<std::string>()("ab"));
+}
+
+
+TEST(CachedHash, StatefulHasher)
+{
+	using Hasher = BF::SeededHasher<std::string>;
+
+	const Hasher                              hasher(12345);
+	BF::CachedHash<std::string, Hasher>       value("a", hasher);
+	const BF::CachedHash<std::string, Hasher> otherSeed("a", Hasher(6789));
+
+	EXPECT_EQ(value.GetHashValue(), hasher("a"));
+	EXPECT_NE(value.GetHashValue(), otherSeed.GetHashValue());
+
+	value.Modify([](std::string& str) { str += "b"; });
+	EXPECT_EQ(value.GetHashValue(), hasher("ab"));						// the stored hasher, not 'Hasher()'
+}
+
+
+struct SaltedHasher {												// stateful, without 'GetSeed()' and 'operator=='
+	std::size_t operator()(const std::string& str) const { return std::hash<std::string>()(str) ^ salt; }
+	std::size_t salt;
+};
+
+
+TEST(CachedHash, MixedHashers)
+{
+	using Seeded = BF::CachedHash<std::string, BF::SeededHasher<std::string>>;
+	using Salted = BF::CachedHash<std::string, SaltedHasher>;
+
+	const Seeded seeded1("a", BF::SeededHasher<std::string>(12345));
+	const Seeded seeded2("a", BF::SeededHasher<std::string>(6789));
+	const Seeded seeded3("b", BF::SeededHasher<std::string>(6789));
+
+	ASSERT_NE(seeded1.GetHashValue(), seeded2.GetHashValue());
+	EXPECT_EQ(seeded1, seeded2);										// equal values, different seeds
+	EXPECT_NE(seeded1, seeded3);
+	EXPECT_NE(seeded2, seeded3);
+
+	const Salted salted1("a", SaltedHasher{ 1 });
+	const Salted salted2("a", SaltedHasher{ 2 });
+	EXPECT_EQ(salted1, salted2);
+	EXPECT_NE(salted1, Salted("b", SaltedHasher{ 1 }));
+}
+
+
+}	// namespace
@@ -0,0 +1,196 @@
+#include "BF/ConcurrentHashMap.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "gtest/gtest.h"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+struct WordKey {
+	bool operator==(const WordKey&) const = default;
+
+	BF::Hash BF_GetHash() const { return { std::string_view(word) }; }
+
+	std::string word;
+};
+
+
+TEST(ConcurrentHashMap, Usage)
+{
+	BF::ConcurrentHashMap<WordKey, int> counts;
+
+	EXPECT_TRUE (counts.InsertOrAssign({ "apple" }, 1));
+	EXPECT_FALSE(counts.InsertOrAssign({ "apple" }, 2));
+	EXPECT_EQ(counts.Find({ "apple" }), 2);
+	EXPECT_EQ(counts.Find({ "pear" }), std::nullopt);
+
+	EXPECT_TRUE(counts.Update({ "apple" }, [](int& count) { count++; }));
+	EXPECT_TRUE(counts.Visit({ "apple" }, [](int count) { EXPECT_EQ(count, 3); }));
+	EXPECT_FALSE(counts.Visit({ "pear" }, [](int) { FAIL(); }));
+
+	EXPECT_TRUE (counts.Erase({ "apple" }));
+	EXPECT_FALSE(counts.Erase({ "apple" }));
+	EXPECT_EQ(counts.GetSize(), 0u);
+}
+
+
+// === class ConcurrentHashMap =========================================================================================
+
+TEST(ConcurrentHashMap, Shards)
+{
+	BF::ConcurrentHashMap<int, int, std::hash<int>, std::equal_to<int>, 1> oneShard;
+	BF::ConcurrentHashMap<int, int>                                        map(10'000);
+
+	for (int i = 0; i < 10'000; i++) {
+		oneShard.InsertOrAssign(i, i);
+		map.InsertOrAssign(i, i);
+	}
+
+	EXPECT_EQ(oneShard.GetSize(), 10'000u);
+	EXPECT_EQ(map.GetSize(),      10'000u);
+
+	long long sum = 0;
+	map.VisitAll([&](int key, int value) { sum += key + value; });
+	EXPECT_EQ(sum, 2LL * (9'999 * 10'000 / 2));
+
+	map.Clear();
+	EXPECT_EQ(map.GetSize(), 0u);
+}
+
+
+TEST(ConcurrentHashMap, Threads)
+{
+	constexpr int ThreadCount = 8;
+	constexpr int KeysPerThread = 20'000;
+
+	BF::ConcurrentHashMap<int, int> map;
+	std::atomic<int>                misses = 0;
+
+	{
+		std::vector<std::jthread> threads;
+		for (int t = 0; t < ThreadCount; t++) {
+			threads.emplace_back([&, t] {
+				for (int i = 0; i < KeysPerThread; i++) {
+					const int key = t * KeysPerThread + i;
+					map.InsertOrAssign(key, key);
+					misses += !map.Contains(key);
+					if (i % 2 == 1)
+						map.Erase(key);
+				}
+			});
+		}
+
+		threads.emplace_back([&] {								// a reader, concurrently with the writers
+			for (int i = 0; i < KeysPerThread; i++)
+				map.Visit(i, [&](int value) { misses += (value != i); });
+		});
+	}
+
+	EXPECT_EQ(misses, 0);
+	EXPECT_EQ(map.GetSize(), std::size_t(ThreadCount * KeysPerThread / 2));
+	for (int key = 0; key < ThreadCount * KeysPerThread; key++)
+		ASSERT_EQ(map.Find(key), key % 2 == 0 ? std::optional<int>(key) : std::nullopt);
+}
+
+
+// === Benchmark =======================================================================================================
+// Not run by default, run it with '--gtest_also_run_disabled_tests --gtest_filter=*ConcurrentHashMap*Benchmark'. For
+// 1 to 64 threads, it prints the throughput of a read-heavy (90% finds) and a write-heavy (10% finds, the rest inserts
+// and erases) mix of operations on random keys, for 'ConcurrentHashMap', and for 'LockedMap' (an 'std::unordered_map'
+// behind one mutex).
+
+class LockedMap {
+public:
+	std::optional<int> Find(int key) const {
+		std::lock_guard lock(mMutex);
+		const auto it = mMap.find(key);
+		return it != mMap.end() ? std::optional<int>(it->second) : std::nullopt;
+	}
+
+	void InsertOrAssign(int key, int value) {
+		std::lock_guard lock(mMutex);
+		mMap.insert_or_assign(key, value);
+	}
+
+	void Erase(int key) {
+		std::lock_guard lock(mMutex);
+		mMap.erase(key);
+	}
+
+private:
+	mutable std::mutex           mMutex;
+	std::unordered_map<int, int> mMap;
+};
+
+
+constexpr int BenchmarkKeyCount = 1 << 20;
+
+
+// Returns millions of operations per second.
+template <class Map>
+double MeasureMix(Map& map, unsigned threadCount, unsigned findPercent)
+{
+	constexpr int OpsPerThread = 1'000'000;
+
+	std::atomic<int> found = 0;
+	const auto       start = std::chrono::steady_clock::now();
+	{
+		std::vector<std::jthread> threads;
+		for (unsigned t = 0; t < threadCount; t++) {
+			threads.emplace_back([&, t] {
+				std::mt19937 random(t);
+				int          localFound = 0;
+				for (int i = 0; i < OpsPerThread; i++) {
+					const int      key = static_cast<int>(random() % BenchmarkKeyCount);
+					const unsigned op  = random() % 100;
+					if (op < findPercent)
+						localFound += map.Find(key).has_value();
+					else if (op % 2 == 0)
+						map.InsertOrAssign(key, i);
+					else
+						map.Erase(key);
+				}
+
+				found += localFound;
+			});
+		}
+	}
+
+	const std::chrono::duration<double, std::micro> time = std::chrono::steady_clock::now() - start;
+	EXPECT_GT(found, 0);
+	return static_cast<double>(threadCount) * OpsPerThread / time.count();
+}
+
+
+TEST(ConcurrentHashMap, DISABLED_Benchmark)
+{
+	for (unsigned findPercent : { 90u, 10u }) {
+		for (unsigned threadCount : { 1u, 2u, 4u, 8u, 16u, 32u, 64u }) {
+			BF::ConcurrentHashMap<int, int> concurrent;
+			LockedMap                       locked;
+			for (int key = 0; key < BenchmarkKeyCount; key += 2) {	// half of the finds and erases hit
+				concurrent.InsertOrAssign(key, key);
+				locked.InsertOrAssign(key, key);
+			}
+
+			const double concurrentOps = MeasureMix(concurrent, threadCount, findPercent);
+			const double lockedOps     = MeasureMix(locked, threadCount, findPercent);
+			std::printf("%2u%% finds %2u threads: %7.1f Mops/s ConcurrentHashMap %7.1f Mops/s LockedMap\n", findPercent,
+						threadCount, concurrentOps, lockedOps);
+		}
+	}
+}
+
+
+}	// namespace
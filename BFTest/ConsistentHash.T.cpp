@@ -0,0 +1,155 @@
+#include "BF/ConsistentHash.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+struct AccountKey {
+	BF::Hash BF_GetHash() const { return { mRegion, mId }; }
+
+	UInt32 mRegion;
+	UInt64 mId;
+};
+
+
+TEST(ConsistentHash, Usage)
+{
+	const AccountKey key = { 3, 12345 };
+
+	const UInt32 shard = BF::JumpConsistentHash(BF::Hash(key), 16);
+	EXPECT_LT(shard, 16u);
+
+	BF::RendezvousSelector<std::string> nodes;
+	nodes.Add("node-a");
+	nodes.Add("node-b", 2.0);									// twice the capacity
+	EXPECT_EQ(nodes.Select(BF::Hash(key)), nodes.Select(BF::Hash(key)));
+}
+
+
+// === JumpConsistentHash() ============================================================================================
+
+static_assert(BF::JumpConsistentHash(UInt64(0), 1) == 0);
+static_assert(BF::JumpConsistentHash(UInt64(12345), 1) == 0);
+
+
+TEST(ConsistentHash, JumpKeyMovement)
+{
+	constexpr UInt64 KeyCount = 100'000;
+
+	for (const UInt32 bucketCount : { 1u, 7u, 100u }) {
+		std::vector<std::size_t> sizes(bucketCount + 1);
+		std::size_t              moved = 0;
+
+		for (UInt64 key = 0; key < KeyCount; key++) {
+			const UInt64 hash   = BF::FMix64(key);
+			const UInt32 before = BF::JumpConsistentHash(hash, bucketCount);
+			const UInt32 after  = BF::JumpConsistentHash(hash, bucketCount + 1);
+
+			ASSERT_TRUE(after == before || after == bucketCount);		// only moves into the new bucket
+			moved += (after != before);
+			sizes[after]++;
+		}
+
+		const double expectedMoved = double(KeyCount) / (bucketCount + 1);	// the minimum possible
+		EXPECT_NEAR(double(moved), expectedMoved, expectedMoved * 0.1);
+
+		for (const std::size_t size : sizes)
+			EXPECT_NEAR(double(size), expectedMoved, expectedMoved * 0.1);	// balanced
+	}
+}
+
+
+// === class RendezvousSelector ========================================================================================
+
+TEST(ConsistentHash, RendezvousKeyMovement)
+{
+	constexpr UInt64 KeyCount = 100'000;
+
+	BF::RendezvousSelector<int> before, after;
+	for (int node = 0; node < 10; node++) {
+		before.Add(node);
+		after.Add(node);
+	}
+	after.Add(10);
+
+	std::size_t moved = 0;
+	for (UInt64 key = 0; key < KeyCount; key++) {
+		const int nodeBefore = before.Select(BF::Hash(key));
+		const int nodeAfter  = after.Select(BF::Hash(key));
+
+		ASSERT_TRUE(nodeAfter == nodeBefore || nodeAfter == 10);	// only moves to the new node
+		moved += (nodeAfter != nodeBefore);
+	}
+
+	EXPECT_NEAR(double(moved), KeyCount / 11.0, KeyCount / 11.0 * 0.1);
+
+	EXPECT_TRUE(after.Remove(10));
+	EXPECT_FALSE(after.Remove(10));
+	for (UInt64 key = 0; key < 1000; key++)
+		ASSERT_EQ(after.Select(BF::Hash(key)), before.Select(BF::Hash(key)));
+}
+
+
+TEST(ConsistentHash, RendezvousWeights)
+{
+	BF::RendezvousSelector<int> nodes;
+	nodes.Add(0, 1.0);
+	nodes.Add(1, 3.0);
+
+	std::size_t heavy = 0;
+	for (UInt64 key = 0; key < 100'000; key++)
+		heavy += (nodes.Select(BF::Hash(key)) == 1);
+
+	EXPECT_NEAR(heavy / 100'000.0, 0.75, 0.01);
+}
+
+
+// === Benchmark =======================================================================================================
+// Not run by default, run it with '--gtest_also_run_disabled_tests --gtest_filter=*ConsistentHash*Benchmark'. For 4 to
+// 1024 nodes, it prints the time of placing one key with 'hash % nodeCount' (not consistent, for reference), with
+// 'JumpConsistentHash()' (O(log nodes)) and with 'RendezvousSelector' (O(nodes)).
+
+template <class Place>
+double MeasurePlacementTime(UInt64 keyCount, Place place)
+{
+	UInt64 sink = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (UInt64 key = 0; key < keyCount; key++)
+		sink += place(BF::FMix64(key));
+
+	const std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+	EXPECT_NE(sink, 0u);
+	return time.count() / static_cast<double>(keyCount);
+}
+
+
+TEST(ConsistentHash, DISABLED_Benchmark)
+{
+	constexpr UInt64 OpCount = 10'000'000;
+
+	for (UInt32 nodeCount = 4; nodeCount <= 1024; nodeCount *= 4) {
+		BF::RendezvousSelector<UInt32> selector;
+		for (UInt32 node = 0; node < nodeCount; node++)
+			selector.Add(node);
+
+		const auto modulo     = [=](UInt64 hash) { return hash % nodeCount; };
+		const auto jump       = [=](UInt64 hash) { return BF::JumpConsistentHash(hash, nodeCount); };
+		const auto rendezvous = [&](UInt64 hash) { return selector.Select(hash); };
+
+		std::printf("%4u nodes: %7.1f ns modulo %7.1f ns JumpConsistentHash %9.1f ns RendezvousSelector\n", nodeCount,
+					MeasurePlacementTime(OpCount, modulo), MeasurePlacementTime(OpCount, jump),
+					MeasurePlacementTime(OpCount / nodeCount, rendezvous));		// 'RendezvousSelector' is O(nodes)
+	}
+}
+
+
+}	// namespace
@@ -0,0 +1,127 @@
+#include "BF/ContentDefinedChunker.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BF/HashBytes.hpp"
+#include "BF/TestUtils.hpp"
+
+
+namespace {
+
+
+std::vector<std::size_t> GetChunkSizes(const BF::ContentDefinedChunker& chunker, std::span<const std::byte> bytes)
+{
+	std::vector<std::size_t> sizes;
+	chunker.ForEachChunk(bytes, [&](std::span<const std::byte> chunk) { sizes.push_back(chunk.size()); });
+	return sizes;
+}
+
+
+std::unordered_set<UInt64> GetChunkHashes(const BF::ContentDefinedChunker& chunker, std::span<const std::byte> bytes)
+{
+	std::unordered_set<UInt64> hashes;
+	chunker.ForEachChunk(bytes, [&](std::span<const std::byte> chunk) { hashes.insert(BF::HashBytes(chunk)); });
+	return hashes;
+}
+
+
+// === Usage example ===================================================================================================
+
+TEST(ContentDefinedChunker, Usage)
+{
+	const std::vector<std::byte> bytes = BF::MakeRandomBytes(1 << 20, 1);
+
+	const BF::ContentDefinedChunker chunker(2048, 8192, 65536);
+
+	std::size_t totalSize = 0;
+	chunker.ForEachChunk(bytes, [&](std::span<const std::byte> chunk) {
+		EXPECT_EQ(chunk.data(), bytes.data() + totalSize);
+		totalSize += chunk.size();
+	});
+
+	EXPECT_EQ(totalSize, bytes.size());
+}
+
+
+// === class ContentDefinedChunker =====================================================================================
+
+TEST(ContentDefinedChunker, Sizes)
+{
+	const std::vector<std::byte>    bytes = BF::MakeRandomBytes(8 << 20, 2);
+	const BF::ContentDefinedChunker chunker(1024, 4096, 16384);
+
+	const std::vector<std::size_t> sizes = GetChunkSizes(chunker, bytes);
+	for (std::size_t i = 0; i + 1 < sizes.size(); i++) {
+		ASSERT_GE(sizes[i], chunker.GetMinSize());
+		ASSERT_LE(sizes[i], chunker.GetMaxSize());
+	}
+
+	const double average = static_cast<double>(bytes.size()) / static_cast<double>(sizes.size());
+	EXPECT_GT(average, 0.75 * chunker.GetAverageSize());
+	EXPECT_LT(average, 1.5 * chunker.GetAverageSize());
+}
+
+
+TEST(ContentDefinedChunker, MaxSize)
+{
+	const std::vector<std::byte>    zeros(100'500);						// the hash never has zero high bits
+	const BF::ContentDefinedChunker chunker(64, 256, 1000);
+
+	const std::vector<std::size_t> sizes = GetChunkSizes(chunker, zeros);
+	for (std::size_t i = 0; i + 1 < sizes.size(); i++)
+		EXPECT_EQ(sizes[i], 1000u);
+
+	EXPECT_EQ(sizes.back(), 500u);
+	EXPECT_EQ(chunker.FindBoundary(std::span(zeros).first(500)), 500u);
+	EXPECT_EQ(chunker.FindBoundary(std::span(zeros).first(10)), 10u);
+	EXPECT_EQ(chunker.FindBoundary({}), 0u);
+}
+
+
+TEST(ContentDefinedChunker, Insertion)
+{
+	const std::vector<std::byte>    bytes = BF::MakeRandomBytes(4 << 20, 3);
+	const BF::ContentDefinedChunker chunker(1024, 4096, 16384);
+
+	std::vector<std::byte> edited = bytes;
+	edited.insert(edited.begin() + 1'000'000, { std::byte(1), std::byte(2), std::byte(3) });
+	edited.erase(edited.begin() + 3'000'000, edited.begin() + 3'000'100);
+
+	const std::unordered_set<UInt64> original = GetChunkHashes(chunker, bytes);
+	const std::unordered_set<UInt64> changed  = GetChunkHashes(chunker, edited);
+
+	std::size_t sharedCount = 0;
+	for (const UInt64 hash : changed)
+		sharedCount += original.contains(hash);
+
+	EXPECT_GE(sharedCount + 10, original.size());					// only the chunks around the edits are new
+}
+
+
+TEST(ContentDefinedChunker, Streaming)
+{
+	const std::vector<std::byte>    bytes = BF::MakeRandomBytes(1 << 20, 4);
+	const BF::ContentDefinedChunker chunker(1024, 4096, 16384);
+
+	std::vector<std::size_t> sizes;
+	std::vector<std::byte>   buffer;
+	std::size_t              readSize = 0;
+	while (readSize < bytes.size() || !buffer.empty()) {
+		while (buffer.size() < chunker.GetMaxSize() && readSize < bytes.size()) {		// reads 1000 bytes at a time
+			const std::size_t end = std::min(readSize + 1000, bytes.size());
+			buffer.insert(buffer.end(), bytes.begin() + readSize, bytes.begin() + end);
+			readSize = end;
+		}
+
+		const std::size_t size = chunker.FindBoundary(buffer);
+		sizes.push_back(size);
+		buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(size));
+	}
+
+	EXPECT_EQ(sizes, GetChunkSizes(chunker, bytes));
+}
+
+
+}	// namespace
@@ -0,0 +1,67 @@
+#include "BF/CountMinSketch.hpp"
+
+#include <string>
+#include "gtest/gtest.h"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+TEST(CountMinSketch, Usage)
+{
+	BF::CountMinSketch<std::string> pageHits;
+	pageHits.Add("index.html", 10);
+	pageHits.Add("about.html");
+
+	EXPECT_GE(pageHits.Estimate("index.html"), 10u);
+	EXPECT_GE(pageHits.Estimate("about.html"), 1u);
+	EXPECT_EQ(pageHits.GetTotal(), 11u);
+}
+
+
+// === class CountMinSketch ============================================================================================
+
+TEST(CountMinSketch, Estimate)
+{
+	BF::CountMinSketch<UInt64, std::hash<UInt64>, 1024, 4> sketch;
+
+	for (UInt64 i = 0; i < 100'000; i++)
+		sketch.Add(i % 10'000);										// every value 10 times
+	for (int i = 0; i < 5000; i++)
+		sketch.Add(777'777);										// a heavy hitter
+
+	const double maxError = 2.72 * double(sketch.GetTotal()) / 1024;
+
+	std::size_t badEstimates = 0;
+	for (UInt64 i = 0; i < 10'000; i++) {
+		ASSERT_GE(sketch.Estimate(i), 10u);							// never underestimates
+		badEstimates += (sketch.Estimate(i) > 10 + maxError);
+	}
+
+	EXPECT_LE(badEstimates, 10'000 * 0.02);							// e^-4
+	EXPECT_GE(sketch.Estimate(777'777), 5000u);
+	EXPECT_LE(sketch.Estimate(777'777), 5000u + maxError);
+}
+
+
+TEST(CountMinSketch, Merge)
+{
+	BF::CountMinSketch<int> all, first, second;
+	for (int i = 0; i < 1000; i++) {
+		all.Add(i % 100);
+		(i % 3 == 0 ? first : second).Add(i % 100);
+	}
+
+	first.Merge(second);
+	EXPECT_EQ(first.GetTotal(), all.GetTotal());
+	for (int i = 0; i < 100; i++)
+		EXPECT_EQ(first.Estimate(i), all.Estimate(i));
+
+	first.Clear();
+	EXPECT_EQ(first.Estimate(1), 0u);
+}
+
+
+}	// namespace
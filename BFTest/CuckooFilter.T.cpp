@@ -0,0 +1,89 @@
+#include "BF/CuckooFilter.hpp"
+
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+TEST(CuckooFilter, Usage)
+{
+	BF::CuckooFilter<std::string> filter(1000, 0.01);
+
+	EXPECT_TRUE(filter.Insert("session-1"));
+	EXPECT_TRUE(filter.MayContain("session-1"));
+
+	EXPECT_TRUE (filter.Erase("session-1"));
+	EXPECT_FALSE(filter.MayContain("session-1"));
+}
+
+
+// === class CuckooFilter ==============================================================================================
+
+TEST(CuckooFilter, FalsePositiveRate)
+{
+	for (const double rate : { 0.1, 0.01, 0.001 }) {
+		BF::CuckooFilter<UInt64> filter(100'000, rate);
+
+		for (UInt64 i = 0; i < 100'000; i++)
+			ASSERT_TRUE(filter.Insert(i));
+
+		for (UInt64 i = 0; i < 100'000; i++)
+			ASSERT_TRUE(filter.MayContain(i));					// no false negatives
+
+		std::size_t falsePositives = 0;
+		for (UInt64 i = 1'000'000; i < 1'100'000; i++)
+			falsePositives += filter.MayContain(i);
+
+		EXPECT_LT(falsePositives / 100'000.0, rate);
+	}
+}
+
+
+TEST(CuckooFilter, Full)
+{
+	BF::CuckooFilter<UInt64> filter(1000, 0.01);
+
+	UInt64 key = 0;
+	while (filter.Insert(key))
+		key++;
+
+	EXPECT_GE(key, 1000u);
+	EXPECT_EQ(filter.GetSize(), key);
+
+	for (UInt64 i = 0; i < key; i++)
+		ASSERT_TRUE(filter.MayContain(i));						// a failed insertion doesn't lose other values
+
+	for (UInt64 i = 0; i < key; i++)
+		ASSERT_TRUE(filter.Erase(i));
+
+	EXPECT_EQ(filter.GetSize(), 0u);
+	EXPECT_TRUE(std::ranges::all_of(filter.GetBytes(), [](std::byte b) { return b == std::byte(0); }));
+}
+
+
+TEST(CuckooFilter, BulkAndSerialization)
+{
+	std::vector<UInt64> keys(1000);
+	std::iota(keys.begin(), keys.end(), 0);
+
+	BF::CuckooFilter<UInt64> filter(keys.size(), 0.01);
+	EXPECT_EQ(filter.InsertMany(keys), keys.size());
+
+	const std::vector<std::byte>   bytes(filter.GetBytes().begin(), filter.GetBytes().end());
+	const BF::CuckooFilter<UInt64> copy(bytes, filter.GetFingerprintBits());
+	EXPECT_EQ(copy.GetSize(), keys.size());
+
+	std::unique_ptr<bool[]> results(new bool[keys.size()]);
+	copy.MayContainMany(keys, std::span(results.get(), keys.size()));
+	EXPECT_TRUE(std::all_of(results.get(), results.get() + keys.size(), [](bool b) { return b; }));
+}
+
+
+}	// namespace
@@ -0,0 +1,291 @@
+#include "BF/FlatHashMap.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BF/TestUtils.hpp"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+struct Point {
+	bool operator==(const Point&) const = default;
+
+	BF::Hash BF_GetHash() const { return { x, y }; }
+
+	int x;
+	int y;
+};
+
+
+TEST(FlatHashMap, Usage)
+{
+	BF::FlatHashMap<Point, std::string> names = { { { 0, 0 }, "origin" }, { { 1, 0 }, "unit" } };
+	names[{ 2, 3 }] = "other";
+
+	EXPECT_EQ(names.GetSize(), 3u);
+	EXPECT_EQ(names.Find({ 0, 0 })->second, "origin");
+	EXPECT_TRUE (names.Contains({ 2, 3 }));
+	EXPECT_FALSE(names.Contains({ 3, 2 }));
+
+	BF::FlatHashSet<Point> points = { { 0, 0 }, { 0, 0 }, { 1, 1 } };
+	EXPECT_EQ(points.GetSize(), 2u);
+}
+
+
+// === class FlatHashSet, FlatHashMap ==================================================================================
+
+BF_COMPILE_TIME_TEST()
+{
+	static_assert(std::forward_iterator<BF::FlatHashMap<int, int>::iterator>);
+	static_assert(std::forward_iterator<BF::FlatHashMap<int, int>::const_iterator>);
+	static_assert(std::is_convertible_v<BF::FlatHashMap<int, int>::iterator, BF::FlatHashMap<int, int>::const_iterator>);
+	static_assert(std::is_same_v<BF::FlatHashSet<int>::iterator, BF::FlatHashSet<int>::const_iterator>);
+
+	BF::FlatHashSet<int> set;
+//	*set.begin() = 1;											// [CompilationError]: you cannot assign to a variable that is const
+	BF::FlatHashMap<int, int> map;
+//	map.begin()->first = 1;										// [CompilationError]: you cannot assign to a variable that is const
+	map.begin()->second = 1;
+}
+
+
+TEST(FlatHashMap, AgainstStdUnorderedMap)
+{
+	std::mt19937_64                          random(7);
+	BF::FlatHashMap<UInt64, std::string>     flat;
+	std::unordered_map<UInt64, std::string>  reference;
+
+	for (int i = 0; i < 200'000; i++) {
+		const UInt64 key = random() % 5'000;						// many erased and reinserted keys, i.e. tombstones
+		switch (random() % 4) {
+			case 0:
+			case 1:
+				EXPECT_EQ(flat.InsertOrAssign(key, std::to_string(i)).second, reference.insert_or_assign(key, std::to_string(i)).second);
+				break;
+
+			case 2:
+				EXPECT_EQ(flat.Erase(key), reference.erase(key));
+				break;
+
+			case 3: {
+				const auto it = flat.Find(key);
+				ASSERT_EQ(it != flat.end(), reference.contains(key));
+				if (it != flat.end())
+					EXPECT_EQ(it->second, reference.at(key));
+				break;
+			}
+		}
+	}
+
+	ASSERT_EQ(flat.GetSize(), reference.size());
+	EXPECT_LE(flat.GetCapacity(), 16'384u);							// erasing doesn't make the table grow unboundedly
+
+	std::size_t count = 0;
+	for (const auto& [key, value] : flat)
+		count += (reference.at(key) == value);
+	EXPECT_EQ(count, reference.size());
+}
+
+
+TEST(FlatHashMap, Reserve)
+{
+	BF::FlatHashSet<int> set;
+	EXPECT_EQ(set.GetCapacity(), 0u);
+	EXPECT_EQ(set.begin(), set.end());
+
+	set.Reserve(1000);
+	const std::size_t capacity = set.GetCapacity();
+	for (int i = 0; i < 1000; i++)
+		set.Insert(i);
+
+	EXPECT_EQ(set.GetCapacity(), capacity);							// no rehashing
+	EXPECT_EQ(set.GetSize(), 1000u);
+
+	set.Clear();
+	EXPECT_TRUE(set.IsEmpty());
+	EXPECT_FALSE(set.Contains(7));
+	EXPECT_EQ(set.GetCapacity(), capacity);
+}
+
+
+TEST(FlatHashMap, Erase)
+{
+	BF::FlatHashMap<int, std::string> map;
+	for (int i = 0; i < 100; i++)
+		map.TryEmplace(i, i, 'x');
+
+	for (auto it = map.begin(); it != map.end(); )				// erasing doesn't invalidate other iterators
+		if (it->first % 2 == 0)
+			map.Erase(it++);
+		else
+			++it;
+
+	EXPECT_EQ(map.GetSize(), 50u);
+	EXPECT_FALSE(map.Contains(10));
+	EXPECT_EQ(map.Find(11)->second, std::string(11, 'x'));
+
+	const std::size_t capacity = map.GetCapacity();
+	for (int i = 0; i < 10'000; i++) {							// one element churning: no growth, no unbounded probing
+		map.TryEmplace(1000 + i, "churn");
+		map.Erase(1000 + i);
+	}
+
+	EXPECT_EQ(map.GetSize(), 50u);
+	EXPECT_EQ(map.GetCapacity(), capacity);
+}
+
+
+TEST(FlatHashMap, CopyAndMove)
+{
+	BF::FlatHashMap<std::string, int> map1 = { { "a", 1 }, { "b", 2 } };
+	BF::FlatHashMap<std::string, int> map2 = map1;
+
+	map2["c"] = 3;
+	EXPECT_EQ(map1.GetSize(), 2u);
+	EXPECT_EQ(map2.GetSize(), 3u);
+
+	BF::FlatHashMap<std::string, int> map3 = std::move(map2);
+	EXPECT_EQ(map3["c"], 3);
+
+	map1 = map3;
+	EXPECT_EQ(map1.GetSize(), 3u);
+	EXPECT_EQ(map1["b"], 2);
+}
+
+
+// === Heterogeneous lookup ============================================================================================
+
+struct Person {
+	BF::Hash BF_GetHash() const { return { std::string_view(name), age }; }
+	std::string name;
+	UInt32      age;
+};
+
+
+struct PersonView {
+	using BF_HashesAs = Person;
+	BF::Hash BF_GetHash() const { return { name, age }; }
+	std::string_view name;
+	UInt32           age;
+};
+
+
+bool operator==(const Person& leftOp, const Person& rightOp)		{ return leftOp.name == rightOp.name && leftOp.age == rightOp.age; }
+bool operator==(const Person& leftOp, const PersonView& rightOp)	{ return leftOp.name == rightOp.name && leftOp.age == rightOp.age; }
+
+
+TEST(FlatHashMap, HeterogeneousLookup)
+{
+	BF::FlatHashSet<Person, std::hash<Person>, std::equal_to<>> set = { { "Alice", 30 }, { "Bob", 40 } };
+
+	EXPECT_TRUE (set.Contains(PersonView{ "Alice", 30 }));
+	EXPECT_FALSE(set.Contains(PersonView{ "Alice", 31 }));
+	EXPECT_EQ(set.Find(PersonView{ "Bob", 40 })->age, 40u);
+	EXPECT_EQ(set.Erase(PersonView{ "Bob", 40 }), 1u);
+	EXPECT_EQ(set.GetSize(), 1u);
+
+	set.Erase(set.begin());
+	EXPECT_EQ(set.GetSize(), 0u);
+
+	BF::FlatHashSet<Person> nonTransparent;
+//	nonTransparent.Contains(PersonView{ "Alice", 30 });			// [CompilationError]: cannot convert argument 1 from '`anonymous-namespace'::PersonView' to 'const `anonymous-namespace'::Person &'
+}
+
+
+struct StringHash {
+	using is_transparent = void;
+	std::size_t operator()(std::string_view str) const { return std::hash<std::string_view>()(str); }
+};
+
+
+TEST(FlatHashMap, TransparentEraseIterator)
+{
+	using Map = BF::FlatHashMap<std::string, int, StringHash, std::equal_to<>>;
+
+	Map map = { { "a", 1 }, { "b", 2 } };
+	EXPECT_EQ(map.Erase("c"), 0u);										// heterogeneous
+
+	const Map::iterator it = map.Find("a");
+	map.Erase(it);														// not 'Erase(const KeyArg<iterator>&)'
+	EXPECT_FALSE(map.Contains("a"));
+
+	map.Erase(std::as_const(map).begin());
+	EXPECT_EQ(map.GetSize(), 0u);
+}
+
+
+// === Benchmark =======================================================================================================
+// Not run by default, run it with '--gtest_also_run_disabled_tests --gtest_filter=*FlatHashMap*Benchmark'. For every
+// size, it prints the time of one insert, find of a present key, find of a missing key, and erase, of 'FlatHashMap'
+// and 'std::unordered_map'. The largest size needs about 7 GiB, lower 'MaxSize' if it doesn't fit into the memory.
+
+template <class Map>
+void BenchmarkMap(const char* mapName, const std::vector<UInt64>& keys, std::size_t roundCount)
+{
+	constexpr bool IsFlat = requires (Map map) { map.GetSize(); };
+
+	std::chrono::duration<double, std::nano> insertTime{}, findHitTime{}, findMissTime{}, eraseTime{};
+	std::size_t                              sink = 0;
+
+	const auto measure = [&keys](std::chrono::duration<double, std::nano>& time, auto&& op) {
+		const auto start = std::chrono::steady_clock::now();
+		for (const UInt64 key : keys)
+			op(key);
+
+		time += std::chrono::steady_clock::now() - start;
+	};
+
+	for (std::size_t round = 0; round < roundCount; round++) {
+		Map map;
+		if constexpr (IsFlat) {
+			measure(insertTime,   [&](UInt64 key) { map.Insert({ key, key }); });
+			measure(findHitTime,  [&](UInt64 key) { sink += map.Find(key) != map.end(); });
+			measure(findMissTime, [&](UInt64 key) { sink += map.Find(key | 1) != map.end(); });	// keys are even
+			measure(eraseTime,    [&](UInt64 key) { sink += map.Erase(key); });
+		} else {
+			measure(insertTime,   [&](UInt64 key) { map.insert({ key, key }); });
+			measure(findHitTime,  [&](UInt64 key) { sink += map.find(key) != map.end(); });
+			measure(findMissTime, [&](UInt64 key) { sink += map.find(key | 1) != map.end(); });
+			measure(eraseTime,    [&](UInt64 key) { sink += map.erase(key); });
+		}
+	}
+
+	const double opCount = static_cast<double>(keys.size() * roundCount);
+	std::printf("%-20s %11zu elements %7.1f ns insert %7.1f ns find-hit %7.1f ns find-miss %7.1f ns erase\n",
+				mapName, keys.size(), insertTime.count() / opCount, findHitTime.count() / opCount,
+				findMissTime.count() / opCount, eraseTime.count() / opCount);
+	EXPECT_NE(sink, 0u);
+}
+
+
+TEST(FlatHashMap, DISABLED_Benchmark)
+{
+	constexpr std::size_t MaxSize    = 100'000'000;
+	constexpr std::size_t MinOpCount = 10'000'000;				// small sizes are repeated, for a stable time
+
+	std::mt19937_64 random(1);
+
+	for (std::size_t size = 1'000; size <= MaxSize; size *= 10) {
+		std::vector<UInt64> keys(size);
+		for (UInt64& key : keys)
+			key = random() & ~UInt64(1);
+
+		const std::size_t roundCount = std::max<std::size_t>(MinOpCount / size, 1);
+		BenchmarkMap<BF::FlatHashMap<UInt64, UInt64>>   ("FlatHashMap",        keys, roundCount);
+		BenchmarkMap<std::unordered_map<UInt64, UInt64>>("std::unordered_map", keys, roundCount);
+	}
+}
+
+
+}	// namespace
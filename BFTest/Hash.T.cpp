@@ -1,6 +1,15 @@
 #include "BF/Hash.hpp"
 
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
 #include <unordered_set>
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
 #include "BF/TestUtils.hpp"
 
 
@@ -497,8 +506,500 @@ constexpr std::size_t BF_DUMMY = std::hash<ConstexprF>()({});
 
 // BF::Hash: outside std::hash it is not convertible to std::size_t ====================================================
 
-// std::size_t BF_DUMMY = BF::Hash(0);							// [CompilationError]: 'BF::Hash::operator unsigned __int64': cannot access private member
-// std::size_t BF_DUMMY(BF::Hash(0));							// [CompilationError]: 'BF::Hash::operator unsigned __int64': cannot access private member
+// std::size_t BF_DUMMY = BF::Hash(0);							// [CompilationError]: ::operator unsigned __int64': cannot access private member
+// std::size_t BF_DUMMY(BF::Hash(0));							// [CompilationError]: ::operator unsigned __int64': cannot access private member
+
+
+// === BF::Hash: hashable itself ======================================================================================
+
+static_assert(BF::StdHashable<BF::Hash>);
+static_assert(BF::StdHashable<BF::BasicHash<BF::WideMulCombinator>>);
+static_assert(std::hash<BF::Hash>()(BF::Hash(ConstexprHashable(123))) == 123);
+static_assert(std::hash<BF::Hash>()(BF::Hash::FromValue(456)) == 456);							// precomputed value
+static_assert(std::hash<BF::AvalancheHash>()(BF::AvalancheHash::FromValue(456)) == 456);
+
+
+// === BF::BasicHash: combinators ======================================================================================
+
+static_assert(std::is_same_v<BF::Hash, BF::BasicHash<BF::FNV1aCombinator>>);
+static_assert(BF::HashCombinatorPolicy<BF::FNV1aCombinator>);
+static_assert(BF::HashCombinatorPolicy<BF::WideMulCombinator>);
+static_assert(BF::HashCombinatorPolicy<BF::MultiLaneCombinator>);
+static_assert(!BF::HashCombinatorPolicy<int>);
+
+
+template <class Combinator>
+struct WithCombinator {
+	constexpr BF::BasicHash<Combinator> BF_GetHash() const { return { m1, m2 }; }
+	ConstexprHashable m1;
+	ConstexprHashable m2;
+};
+
+
+template <class Combinator>
+constexpr std::size_t CombineSizes(auto... sizes)
+{
+	return std::hash<WithCombinator<Combinator>>()({ ConstexprHashable(sizes)... });
+}
+
+
+static_assert(BF::StdHashable<WithCombinator<BF::FNV1aCombinator>>);
+static_assert(BF::StdHashable<WithCombinator<BF::WideMulCombinator>>);
+static_assert(BF::StdHashable<WithCombinator<BF::MultiLaneCombinator>>);
+
+static_assert(CombineSizes<BF::WideMulCombinator>  (1, 2) != CombineSizes<BF::WideMulCombinator>  (2, 1));		// constexpr, and depends on order
+static_assert(CombineSizes<BF::MultiLaneCombinator>(1, 2) != CombineSizes<BF::MultiLaneCombinator>(2, 1));
+
+
+template <class Combinator>
+void TestCombinator()
+{
+	constexpr std::size_t Count = 8;
+	std::unordered_set<std::size_t> hashes;
+
+	for (std::size_t i = 0; i < 1000; i++) {
+		Combinator combinator;
+		for (std::size_t j = 0; j < Count; j++)
+			combinator.Add(j == i % Count ? i : 0);					// keys differing in a single member
+		hashes.insert(combinator.Get());
+	}
+
+	EXPECT_EQ(hashes.size(), 1000u);
+
+	Combinator single;
+	single.Add(123);
+	EXPECT_EQ(single.Get(), Combinator::Single(123));
+}
+
+
+// Keys built from 'key(x)' for different 'x' must have different hash values.
+template <class Combinator>
+void TestNoCollidingFamily(auto key)
+{
+	std::unordered_set<std::size_t> hashes;
+
+	for (std::size_t x = 0; x < 1000; x++) {
+		Combinator combinator;
+		for (const std::size_t hash : key(x))
+			combinator.Add(hash);
+		hashes.insert(combinator.Get());
+	}
+
+	EXPECT_EQ(hashes.size(), 1000u);
+}
+
+
+TEST(Hash, WideMulCombinatorNotAbsorbing)
+{
+	constexpr std::size_t Secret0 = 0xa0761d6478bd642f;		// the secrets of 'WideMulCombinator'
+	constexpr std::size_t Secret1 = 0xe7037ed1a0b428db;
+	constexpr std::size_t Secret2 = 0x8ebc6af09c88c6e3;
+	using Key = std::vector<std::size_t>;
+
+	// A zero product used to reset the state, so these families collided for every 'x'.
+	TestNoCollidingFamily<BF::WideMulCombinator>([](std::size_t x) { return Key{ x, Secret0 }; });
+	TestNoCollidingFamily<BF::WideMulCombinator>([](std::size_t x) { return Key{ Secret0, x, 0 }; });
+	TestNoCollidingFamily<BF::WideMulCombinator>([](std::size_t x) { return Key{ x, 0, Secret1 }; });
+	TestNoCollidingFamily<BF::WideMulCombinator>([](std::size_t x) { return Key{ x, x }; });
+	TestNoCollidingFamily<BF::WideMulCombinator>([](std::size_t x) { return Key{ x, Secret0 ^ Secret2 }; });
+	TestNoCollidingFamily<BF::WideMulCombinator>([](std::size_t x) { return Key{ Secret0 ^ Secret1, x }; });
+}
+
+
+TEST(Hash, Combinators)
+{
+	TestCombinator<BF::WideMulCombinator>();
+	TestCombinator<BF::MultiLaneCombinator>();
+
+	EXPECT_EQ(BF::FNV1aCombinator::Single(123), 123u);
+	EXPECT_NE(BF::WideMulCombinator::Single(0),   BF::WideMulCombinator::Single(1));
+	EXPECT_NE(BF::MultiLaneCombinator::Single(0), BF::MultiLaneCombinator::Single(1));
+}
+
+
+// === BF::Avalanche, BF::AvalancheHash ================================================================================
+
+static_assert(BF::HashCombinatorPolicy<BF::Avalanche<>>);
+static_assert(BF::HashCombinatorPolicy<BF::Avalanche<BF::WideMulCombinator>>);
+static_assert(BF::FMix64(0) == 0);							// a bijection, so 0 has to go somewhere
+static_assert(BF::Avalanche<>::Single(0x1234) == BF::FMix64(0x1234));
+static_assert(CombineSizes<BF::Avalanche<>>(1, 2) == BF::FMix64(CombineSizes<BF::FNV1aCombinator>(1, 2)));
+
+
+struct AlignedId {
+	bool operator==(const AlignedId&) const = default;
+	BF::AvalancheHash BF_GetHash() const { return { id }; }
+	UInt64 id;
+};
+
+
+TEST(Hash, AvalancheBucketDistribution)
+{
+	constexpr std::size_t BucketCount = 4096;						// a power of two table, indexed with the low bits
+	constexpr std::size_t KeyCount    = BucketCount;
+
+	std::vector<std::size_t> bucketLoads(BucketCount);
+	for (UInt64 i = 0; i < KeyCount; i++)
+		bucketLoads[std::hash<AlignedId>()({ i * 64 }) % BucketCount]++;		// the low 6 bits are always zero
+
+	const std::size_t usedBuckets = BucketCount - std::ranges::count(bucketLoads, 0u);
+	const std::size_t maxLoad     = std::ranges::max(bucketLoads);
+
+	EXPECT_GT(usedBuckets, BucketCount / 2);						// 63% is expected for a random function
+	EXPECT_LT(maxLoad, 16u);
+
+	std::unordered_set<AlignedId> set;
+	for (UInt64 i = 0; i < KeyCount; i++)
+		set.insert({ i * 64 });
+
+	EXPECT_EQ(set.size(), KeyCount);
+	EXPECT_TRUE(set.contains({ 64 }));
+	EXPECT_FALSE(set.contains({ 65 }));
+}
+
+
+// Not run by default, run it with '--gtest_also_run_disabled_tests --gtest_filter=*AvalancheBenchmark'. For IDs with
+// a stride of 64 and 4096 (e.g. aligned pointers), it prints how many distinct home slots they have in a power of two
+// sized linear probing table, indexed with the low bits of the hash, and the time of one insert and one lookup. With
+// 'BF::Hash' (the identity for an integer with some Standard Libraries), and with 'BF::AvalancheHash'.
+
+struct PlainAlignedId {
+	bool operator==(const PlainAlignedId&) const = default;
+	BF::Hash BF_GetHash() const { return { id }; }
+	UInt64 id;
+};
+
+
+template <class Key>
+class PowerOfTwoTable {
+public:
+	explicit PowerOfTwoTable(std::size_t capacity) :
+		mSlots(capacity),
+		mUsed(capacity)
+	{
+	}
+
+	void Insert(const Key& key) {
+		const std::size_t index = FindIndex(key);
+		mSlots[index] = key;
+		mUsed[index]  = true;
+	}
+
+	bool Contains(const Key& key) const {
+		return mUsed[FindIndex(key)];
+	}
+
+private:
+	std::size_t FindIndex(const Key& key) const {					// the slot of 'key', or the empty one after its run
+		const std::size_t mask  = mSlots.size() - 1;
+		std::size_t       index = std::hash<Key>()(key) & mask;
+		while (mUsed[index] && !(mSlots[index] == key))
+			index = (index + 1) & mask;
+
+		return index;
+	}
+
+	std::vector<Key>   mSlots;
+	std::vector<UInt8> mUsed;
+};
+
+
+template <class Key>
+void BenchmarkAvalanche(const char* name, UInt64 stride)
+{
+	constexpr std::size_t KeyCount = 1 << 14;
+	constexpr std::size_t Capacity = 2 * KeyCount;
+
+	std::unordered_set<std::size_t> homeSlots;
+	for (UInt64 i = 0; i < KeyCount; i++)
+		homeSlots.insert(std::hash<Key>()({ i * stride }) & (Capacity - 1));
+
+	PowerOfTwoTable<Key> table(Capacity);
+	std::size_t          found = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (UInt64 i = 0; i < KeyCount; i++)
+		table.Insert({ i * stride });
+
+	const auto middle = std::chrono::steady_clock::now();
+	for (UInt64 i = 0; i < 2 * KeyCount; i++)
+		found += table.Contains({ i * stride / 2 });				// every second one is missing
+
+	const std::chrono::duration<double, std::nano> insertTime = middle - start;
+	const std::chrono::duration<double, std::nano> lookupTime = std::chrono::steady_clock::now() - middle;
+
+	std::printf("%-18s stride %4llu: %5zu home slots %9.1f ns insert %9.1f ns lookup\n", name,
+				static_cast<unsigned long long>(stride), homeSlots.size(), insertTime.count() / KeyCount,
+				lookupTime.count() / (2 * KeyCount));
+	EXPECT_EQ(found, KeyCount);
+}
+
+
+TEST(Hash, DISABLED_AvalancheBenchmark)
+{
+	for (const UInt64 stride : { 64, 4096 }) {
+		BenchmarkAvalanche<PlainAlignedId>("BF::Hash",          stride);
+		BenchmarkAvalanche<AlignedId>     ("BF::AvalancheHash", stride);
+	}
+}
+
+
+// === BF::Seeded, BF::SeededHash ======================================================================================
+
+static_assert(BF::HashCombinatorPolicy<BF::Seeded<>>);
+static_assert(BF::HashCombinatorPolicy<BF::Seeded<BF::FNV1aCombinator>>);
+
+
+template <class HashType>
+struct Pair {
+	HashType BF_GetHash() const { return { first, second }; }
+	ConstexprHashable first;
+	ConstexprHashable second;
+};
+
+
+// FNV-1a is invertible, so knowing the fixed offset basis, the second member can be chosen to cancel the first one.
+template <class HashType>
+std::size_t CountDistinctHashesOfCollidingPairs()
+{
+	constexpr std::size_t FNVOffsetBasis = 14695981039346656037;
+	constexpr std::size_t FNVPrime       = 1099511628211;
+
+	std::unordered_set<std::size_t> hashes;
+	for (std::size_t a = 0; a < 1000; a++) {
+		const std::size_t b = ((FNVOffsetBasis ^ a) * FNVPrime) ^ 0x1234;
+		hashes.insert(std::hash<Pair<HashType>>()({ { a }, { b } }));
+	}
+
+	return hashes.size();
+}
+
+
+TEST(Hash, Seeded)
+{
+	EXPECT_EQ(BF::GetProcessHashSeed(), BF::GetProcessHashSeed());
+	EXPECT_NE(BF::Seeded<>::Single(0), 0u);
+	EXPECT_NE(BF::Seeded<>::Single(0), BF::Seeded<>::Single(1));
+	EXPECT_EQ(std::hash<BF::SeededHash>()(BF::SeededHash(ConstexprHashable(7))), BF::Seeded<>::Single(7));
+
+	EXPECT_EQ(CountDistinctHashesOfCollidingPairs<BF::Hash>(), 1u);					// a collision storm
+	EXPECT_EQ(CountDistinctHashesOfCollidingPairs<BF::SeededHash>(), 1000u);
+}
+
+
+TEST(Hash, SeedNotErased)
+{
+	constexpr std::size_t Secret0 = 0xa0761d6478bd642f;		// 'WideMulCombinator' multiplied it to zero with the seed
+
+	std::unordered_set<std::size_t> hashes;
+	for (UInt64 seed = 0; seed < 1000; seed++) {
+		BF::ImpHash::HashCombinator<BF::WideMulCombinator> hc(seed);
+		hc.AddHash(Secret0);
+		hc.AddHash(1);
+		hc.AddHash(0);
+		hashes.insert(hc.Get());
+	}
+
+	EXPECT_EQ(hashes.size(), 1000u);												// the seeds still differ
+
+	hashes.clear();
+	for (std::size_t x = 0; x < 1000; x++) {
+		BF::Seeded<> combinator;
+		combinator.Add(Secret0);
+		combinator.Add(x);
+		combinator.Add(0);
+		hashes.insert(combinator.Get());
+	}
+
+	EXPECT_EQ(hashes.size(), 1000u);												// '{ Secret0, x, 0 }' keys don't collide
+
+	hashes.clear();
+	for (std::size_t x = 0; x < 1000; x++)
+		hashes.insert(std::hash<BF::SeededHash>()(BF::SeededHash(BF::Hash::FromValue(Secret0), ConstexprHashable(x))));
+
+	EXPECT_EQ(hashes.size(), 1000u);
+}
+
+
+// === BF::HashesAsBytes ===============================================================================================
+
+template <std::size_t Size>
+struct PackedKey {
+	constexpr static bool BF_HashAsBytes = true;
+	bool operator==(const PackedKey&) const = default;
+	UInt8 bytes[Size];
+};
+
+
+struct NotOptedIn {
+	constexpr static bool BF_HashAsBytes = false;
+	UInt64 m;
+};
+
+
+struct PaddedKey {
+	constexpr static bool BF_HashAsBytes = true;
+	bool operator==(const PaddedKey&) const = default;
+	UInt64 m1;
+	UInt8  m2;
+};
+
+
+struct AmbiguousBytes {
+	constexpr static bool BF_HashAsBytes = true;
+	bool operator==(const AmbiguousBytes&) const = default;
+	BF::Hash BF_GetHash() const { return { m }; }
+	UInt64 m;
+};
+
+
+BF_COMPILE_TIME_TEST() { AssertIsHashable<PackedKey<16>, CheckOnlyStd>(); }
+BF_COMPILE_TIME_TEST() { AssertIsHashable<PackedKey<128>, CheckOnlyStd>(); }
+
+static_assert( BF::HashesAsBytes<PackedKey<16>>);
+static_assert(!BF::HashesAsBytes<NotOptedIn>);
+static_assert(!BF::StdHashable<NotOptedIn>);
+static_assert(!BF::HashesAsBytes<UInt64>);
+
+// TRY_HASH_CONTAINER(PaddedKey);								// [CompilationError]: A value of 'Type' can be represented by two distinct bit patterns.
+// TRY_HASH_CONTAINER(AmbiguousBytes);							// [CompilationError]: Ambiguous hashing: 'Type' has both 'BF_HashAsBytes' and 'BF_GetHash()'.
+
+
+template <std::size_t Size>
+void TestHashAsBytes()
+{
+	PackedKey<Size> key{};
+	const std::size_t zeroHash = std::hash<PackedKey<Size>>()(key);
+
+	std::unordered_set<std::size_t> hashes = { zeroHash };
+	for (std::size_t i = 0; i < Size; i++) {
+		key.bytes[i] = 1;											// every byte takes part in the hash
+		hashes.insert(std::hash<PackedKey<Size>>()(key));
+		key.bytes[i] = 0;
+	}
+
+	EXPECT_EQ(hashes.size(), Size + 1);
+	EXPECT_EQ(std::hash<PackedKey<Size>>()(key), zeroHash);
+}
+
+
+TEST(Hash, HashAsBytes)
+{
+	TestHashAsBytes<1>();
+	TestHashAsBytes<3>();
+	TestHashAsBytes<16>();
+	TestHashAsBytes<24>();
+	TestHashAsBytes<32>();
+	TestHashAsBytes<64>();
+	TestHashAsBytes<100>();
+	TestHashAsBytes<128>();
+}
+
+
+// Not run by default, run it with '--gtest_also_run_disabled_tests --gtest_filter=*HashAsBytesBenchmark'. For keys of
+// 16 to 128 bytes, it prints the time of one 'std::hash' call, member by member (a 'BF_GetHash()' of 8, 4 and 1 byte
+// members), and as bytes (the same bytes with 'BF_HashAsBytes').
+
+template <std::size_t Size, class Member>
+struct MemberwiseKey {
+	bool operator==(const MemberwiseKey&) const = default;
+
+	BF::Hash BF_GetHash() const {
+		return [this]<std::size_t... Indices>(std::index_sequence<Indices...>) {
+			return BF::Hash(members[Indices]...);
+		}(std::make_index_sequence<Size / sizeof(Member)>());
+	}
+
+	Member members[Size / sizeof(Member)];
+};
+
+
+template <class Key>
+double MeasureHashTime(const std::vector<PackedKey<sizeof(Key)>>& bytes, std::size_t roundCount)
+{
+	std::vector<Key> keys;
+	for (const auto& key : bytes)
+		keys.push_back(std::bit_cast<Key>(key));
+
+	std::size_t sink = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (std::size_t round = 0; round < roundCount; round++)
+		for (const Key& key : keys)
+			sink += std::hash<Key>()(key);
+
+	const std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+	EXPECT_NE(sink, 0u);
+	return time.count() / static_cast<double>(keys.size() * roundCount);
+}
+
+
+template <std::size_t Size>
+void BenchmarkHashAsBytes()
+{
+	constexpr std::size_t KeyCount   = 4096;						// they fit into the L1 or L2 cache
+	constexpr std::size_t RoundCount = 1000;
+
+	std::vector<PackedKey<Size>> keys(KeyCount);
+	for (std::size_t i = 0; i < KeyCount; i++)
+		for (std::size_t j = 0; j < Size; j++)
+			keys[i].bytes[j] = static_cast<UInt8>(BF::FMix64(i * Size + j));
+
+	std::printf("%3zu bytes: members of 8, 4, 1 bytes %6.1f %6.1f %6.1f ns, as bytes %6.1f ns\n",
+				Size, MeasureHashTime<MemberwiseKey<Size, UInt64>>(keys, RoundCount),
+				MeasureHashTime<MemberwiseKey<Size, UInt32>>(keys, RoundCount),
+				MeasureHashTime<MemberwiseKey<Size, UInt8>>(keys, RoundCount),
+				MeasureHashTime<PackedKey<Size>>(keys, RoundCount));
+}
+
+
+TEST(Hash, DISABLED_HashAsBytesBenchmark)
+{
+	BenchmarkHashAsBytes<16>();
+	BenchmarkHashAsBytes<32>();
+	BenchmarkHashAsBytes<64>();
+	BenchmarkHashAsBytes<128>();
+}
+
+
+// === BF::LookupViewOf: heterogeneous lookup =========================================================================
+
+struct Person {
+	BF::Hash BF_GetHash() const { return { std::string_view(name), age }; }
+	std::string name;
+	UInt32      age;
+};
+
+
+struct PersonView {												// no allocation, and 'Person' cannot be constructed from it
+	using BF_HashesAs = Person;
+	BF::Hash BF_GetHash() const { return { name, age }; }
+	std::string_view name;
+	UInt32           age;
+};
+
+
+bool operator==(const Person& leftOp, const Person& rightOp)		{ return leftOp.name == rightOp.name && leftOp.age == rightOp.age; }
+bool operator==(const Person& leftOp, const PersonView& rightOp)	{ return leftOp.name == rightOp.name && leftOp.age == rightOp.age; }
+
+
+static_assert( BF::LookupViewOf<PersonView, Person>);
+static_assert(!BF::LookupViewOf<Person, PersonView>);
+static_assert(!BF::LookupViewOf<std::string_view, Person>);
+static_assert(!std::is_invocable_v<std::hash<Person>, std::string_view>);
+
+
+TEST(Hash, HeterogeneousLookup)
+{
+	std::unordered_set<Person, std::hash<Person>, std::equal_to<>> set = { { "Alice", 30 }, { "Bob", 40 } };
+
+	const std::string_view alice = "Alice";
+	EXPECT_EQ(std::hash<Person>()(PersonView{ alice, 30 }), std::hash<Person>()(Person{ "Alice", 30 }));
+
+	EXPECT_TRUE (set.contains(PersonView{ alice, 30 }));
+	EXPECT_FALSE(set.contains(PersonView{ alice, 31 }));
+	EXPECT_EQ(set.find(PersonView{ "Bob", 40 })->age, 40u);
+}
 
 
 // === Hashing a class template of a 3rd party library =================================================================
@@ -0,0 +1,179 @@
+#include "BF/Hash128.hpp"
+
+#include <list>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BF/TestUtils.hpp"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+struct Document {
+	BF::Hash128 BF_GetHash128() const {
+		return { mId, std::string_view(mTitle), BF::Hash128Range(mWords) };
+	}
+
+	UInt64                   mId;
+	std::string              mTitle;
+	std::vector<std::string> mWords;
+};
+
+
+TEST(Hash128, Usage)
+{
+	const Document doc1 = { 1, "title", { "a", "b" } };
+	const Document doc2 = { 1, "title", { "a", "b" } };
+	const Document doc3 = { 1, "title", { "ab" } };
+
+	EXPECT_EQ(BF::Hash128(doc1), BF::Hash128(doc2));
+	EXPECT_NE(BF::Hash128(doc1), BF::Hash128(doc3));
+
+	std::unordered_set<BF::Hash128> seen;								// deduplication by the hash value only
+	EXPECT_TRUE(seen.insert(BF::Hash128(doc1)).second);
+	EXPECT_FALSE(seen.insert(BF::Hash128(doc2)).second);
+}
+
+
+// === class Hash128 ===================================================================================================
+
+static_assert(std::is_trivially_copyable_v<BF::Hash128>);
+static_assert(sizeof(BF::Hash128) == 16);
+
+static_assert(BF::Hash128(1) == BF::Hash128(1));
+static_assert(BF::Hash128(1) != BF::Hash128(2));
+static_assert(BF::Hash128(1, 2) != BF::Hash128(2, 1));
+static_assert(BF::Hash128(1, 2) != BF::Hash128(1, 2, 0));
+static_assert(BF::Hash128("ab", "c") != BF::Hash128("a", "bc"));				// the sizes are hashed too
+static_assert(BF::Hash128("abc") == BF::Hash128(std::string_view("abc")));
+static_assert(BF::Hash128(0.0) == BF::Hash128(-0.0));
+static_assert(BF::Hash128(BF::Hash128(1)) == BF::Hash128(1));					// copied, not rehashed
+
+enum class Color { Red, Green };
+static_assert(BF::Hash128(Color::Green) == BF::Hash128(1));
+
+struct NotHashable {};
+// BF::Hash128 BF_DUMMY{ NotHashable() };									// [CompilationError]: 'Type' is not hashable by 'BF::Hash128'.
+
+
+BF_COMPILE_TIME_TEST()
+{
+	constexpr std::string_view str = "a string, which is longer than sixteen characters";
+	static_assert(BF::Hash128(str) == BF::Hash128(std::string(str)));
+
+	constexpr UInt16 array[] = { 1, 2, 3, 4, 5 };
+	static_assert(BF::Hash128(BF::Hash128Range(array)) != BF::Hash128(BF::Hash128Range(std::span(array, 4))));
+}
+
+
+TEST(Hash128, RunTimeMatchesCompileTime)
+{
+	constexpr std::string_view Str     = "a string, which is longer than sixteen characters";
+	constexpr UInt16           Array[] = { 1, 2, 3, 4, 5 };
+	constexpr BF::Hash128      StrHash   = BF::Hash128(Str);
+	constexpr BF::Hash128      ArrayHash = BF::Hash128(BF::Hash128Range(Array));
+
+	const std::string        str(Str);
+	const std::vector<UInt16> vec(std::begin(Array), std::end(Array));
+	EXPECT_EQ(BF::Hash128(str), StrHash);
+	EXPECT_EQ(BF::Hash128(BF::Hash128Range(vec)), ArrayHash);
+}
+
+
+TEST(Hash128, Stable)											// the values must not change between versions
+{
+	EXPECT_EQ(BF::Hash128().GetLow(),         0xaafc5697fdc9f75a);
+	EXPECT_EQ(BF::Hash128().GetHigh(),        0x82eda7ed9680b0dd);
+	EXPECT_EQ(BF::Hash128("abc").GetLow(),    0x44e249f2520f53a9);
+	EXPECT_EQ(BF::Hash128("abc").GetHigh(),   0x1817f999d7a2aba6);
+	EXPECT_EQ(BF::Hash128(1, 2, 3).GetLow(),  0x8307f995ab7298a5);
+	EXPECT_EQ(BF::Hash128(1, 2, 3).GetHigh(), 0xc2fc16b97f7fd0f2);
+}
+
+
+TEST(Hash128, NoCollisions)
+{
+	std::mt19937_64                 random(42);
+	std::unordered_set<BF::Hash128> hashes;
+	std::unordered_set<UInt64>      lowHalves;
+	std::unordered_set<UInt64>      highHalves;
+
+	for (int i = 0; i < 100'000; i++) {
+		const BF::Hash128 hash(i);
+		EXPECT_TRUE(hashes.insert(hash).second);
+		lowHalves.insert(hash.GetLow());
+		highHalves.insert(hash.GetHigh());
+	}
+
+	for (int i = 0; i < 100'000; i++) {
+		std::string str(static_cast<std::size_t>(random() % 40), '\0');
+		for (char& c : str)
+			c = static_cast<char>(random());
+
+		hashes.insert(BF::Hash128(str, i));
+	}
+
+	EXPECT_EQ(hashes.size(), 200'000u);
+	EXPECT_EQ(lowHalves.size(), 100'000u);										// both halves are well mixed
+	EXPECT_EQ(highHalves.size(), 100'000u);
+}
+
+
+TEST(Hash128, BitChanges)
+{
+	const std::string base(100, 'x');
+	const BF::Hash128 baseHash(base);
+
+	for (std::size_t i = 0; i < base.size() * 8; i++) {
+		std::string changed = base;
+		changed[i / 8] ^= static_cast<char>(1 << (i % 8));
+
+		const BF::Hash128 hash(changed);
+		const int         lowDiff  = std::popcount(hash.GetLow() ^ baseHash.GetLow());
+		const int         highDiff = std::popcount(hash.GetHigh() ^ baseHash.GetHigh());
+		EXPECT_GT(lowDiff, 10);
+		EXPECT_GT(highDiff, 10);
+	}
+}
+
+
+// === class Hash128Range ==============================================================================================
+
+TEST(Hash128, Range)
+{
+	const std::vector<int> vec  = { 1, 2, 3 };
+	const std::list<int>   list = { 1, 2, 3 };
+	std::vector<int>       vec2 = vec;
+
+	EXPECT_EQ(BF::Hash128(BF::Hash128Range(vec)), BF::Hash128(BF::Hash128Range(vec2)));
+	vec2[2] = 4;																// the whole range is hashed, not a sample
+	EXPECT_NE(BF::Hash128(BF::Hash128Range(vec)), BF::Hash128(BF::Hash128Range(vec2)));
+
+	EXPECT_EQ(BF::Hash128(BF::Hash128Range(list)), BF::Hash128(1, 2, 3, 3));	// element by element, then the size
+	EXPECT_NE(BF::Hash128(BF::Hash128Range(vec)), BF::Hash128(BF::Hash128Range(list)));
+
+	std::vector<int> large(100'000, 7);
+	const BF::Hash128 largeHash = BF::Hash128(BF::Hash128Range(large));
+	large[54'321] = 8;
+	EXPECT_NE(BF::Hash128(BF::Hash128Range(large)), largeHash);
+}
+
+
+// === class Hash128RawMemory ==========================================================================================
+
+TEST(Hash128, RawMemory)
+{
+	const UInt32 values[] = { 1, 2, 3 };
+
+	EXPECT_EQ(BF::Hash128(BF::Hash128RawMemory(values)), BF::Hash128(BF::Hash128Range(values)));
+	EXPECT_EQ(BF::Hash128(BF::Hash128RawMemory(values, sizeof(values))), BF::Hash128(BF::Hash128Range(values)));
+	EXPECT_NE(BF::Hash128(BF::Hash128RawMemory(values, 8)), BF::Hash128(BF::Hash128Range(values)));
+}
+
+
+}	// namespace
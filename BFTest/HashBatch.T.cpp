@@ -0,0 +1,85 @@
+#include "BF/HashBatch.hpp"
+
+#include <vector>
+#include "gtest/gtest.h"
+
+
+namespace {
+
+
+// === HashBatch() =====================================================================================================
+
+template <class Combinator, class Type>
+void TestHashBatch(std::size_t size)
+{
+	std::vector<Type> keys(size);
+	for (std::size_t i = 0; i < size; i++)
+		keys[i] = static_cast<Type>(i * 64 + 7);
+
+	std::vector<std::size_t> hashes(size, 0xBAAD);
+	BF::HashBatch<Combinator>(std::span<const Type>(keys), std::span<std::size_t>(hashes));
+
+	for (std::size_t i = 0; i < size; i++)
+		EXPECT_EQ(hashes[i], std::hash<BF::BasicHash<Combinator>>()(BF::BasicHash<Combinator>(keys[i])));
+}
+
+
+template <class Combinator>
+void TestHashBatchSizes()
+{
+	for (std::size_t size : { 0, 1, 7, 8, 9, 16, 17, 1000 }) {
+		TestHashBatch<Combinator, UInt32>(size);
+		TestHashBatch<Combinator, UInt64>(size);
+		TestHashBatch<Combinator, Int16> (size);
+	}
+}
+
+
+TEST(HashBatch, SameAsHash)
+{
+	TestHashBatchSizes<BF::FNV1aCombinator>();
+	TestHashBatchSizes<BF::Avalanche<>>();
+	TestHashBatchSizes<BF::WideMulCombinator>();
+	TestHashBatchSizes<BF::MultiLaneCombinator>();
+}
+
+
+TEST(HashBatch, DefaultCombinator)
+{
+	const UInt64 keys[3] = { 1, 2, 3 };
+	std::size_t  hashes[3];
+
+	BF::HashBatch(std::span<const UInt64>(keys), std::span<std::size_t>(hashes));
+
+	for (std::size_t i = 0; i < 3; i++)
+		EXPECT_EQ(hashes[i], std::hash<UInt64>()(keys[i]));
+}
+
+
+#if defined(IMP_BF_X64)
+
+IMP_BF_TARGET_AVX2
+void FMix64x4(const UInt64 (&hashes)[4], UInt64 (&mixed)[4])
+{
+	const __m256i result = BF::ImpHash::FMix64x4(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(hashes)));
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(mixed), result);
+}
+
+
+TEST(HashBatch, FMix64x4)
+{
+	if (!BF::ImpHash::HasAVX2())
+		GTEST_SKIP() << "The CPU has no AVX2.";
+
+	const UInt64 hashes[4] = { 0, 1, 0x0123456789abcdef, MaxUInt64 };
+	UInt64       mixed[4];
+	FMix64x4(hashes, mixed);
+
+	for (std::size_t i = 0; i < 4; i++)
+		EXPECT_EQ(mixed[i], BF::FMix64(hashes[i]));
+}
+
+#endif
+
+
+}	// namespace
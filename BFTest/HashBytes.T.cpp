@@ -0,0 +1,143 @@
+#include "BF/HashBytes.hpp"
+
+#include <unordered_set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BF/HashRange.hpp"
+#include "BF/TestUtils.hpp"
+
+
+namespace {
+
+
+// === HashBytes() =====================================================================================================
+
+TEST(HashBytes, AllSizes)
+{
+	const std::vector<std::byte> bytes = BF::MakeRandomBytes(5000, 1);
+
+	std::unordered_set<UInt64> hashes;
+	for (std::size_t size = 0; size <= bytes.size(); size++)		// both kernels, and all partial stripes and blocks
+		hashes.insert(BF::HashBytes(std::span(bytes).first(size)));
+
+	EXPECT_EQ(hashes.size(), bytes.size() + 1);
+}
+
+
+TEST(HashBytes, EveryByteMatters)
+{
+	for (std::size_t size : { 100, 255, 256, 1000, 1023, 1024, 1025, 4096, 10'000 }) {
+		std::vector<std::byte> bytes = BF::MakeRandomBytes(size, size);
+		const UInt64           hash  = BF::HashBytes(bytes);
+
+		std::unordered_set<UInt64> hashes = { hash };
+		for (std::size_t i = 0; i < size; i++) {
+			bytes[i] ^= std::byte(1 << (i % 8));
+			hashes.insert(BF::HashBytes(bytes));
+			bytes[i] ^= std::byte(1 << (i % 8));
+		}
+
+		EXPECT_EQ(hashes.size(), size + 1) << "size: " << size;
+		EXPECT_EQ(BF::HashBytes(bytes), hash);
+	}
+}
+
+
+TEST(HashBytes, ZeroBytes)
+{
+	std::unordered_set<UInt64> hashes;
+	for (std::size_t size = 1024; size < 4096; size += 64) {			// whole stripes of zeros
+		const std::vector<std::byte> zeros(size);
+		hashes.insert(BF::HashBytes(zeros));
+	}
+
+	EXPECT_EQ(hashes.size(), (4096u - 1024) / 64);
+}
+
+
+TEST(HashBytes, Seed)
+{
+	for (std::size_t size : { 0, 10, 100, 1000 }) {
+		const std::vector<std::byte> bytes = BF::MakeRandomBytes(size, 7);
+		EXPECT_NE(BF::HashBytes(bytes, 1), BF::HashBytes(bytes, 2));
+		EXPECT_EQ(BF::HashBytes(bytes, 1), BF::HashBytes(bytes, 1));
+	}
+}
+
+
+TEST(HashBytes, Alignment)
+{
+	const std::vector<std::byte> bytes = BF::MakeRandomBytes(3000, 3);
+
+	std::vector<std::byte> shifted(bytes.size() + 7);
+	for (std::size_t offset = 0; offset < 8; offset++) {
+		std::ranges::copy(bytes.begin(), bytes.end() - 7, shifted.begin() + offset);
+		EXPECT_EQ(BF::HashBytes(std::span(shifted).subspan(offset, bytes.size() - 7)), BF::HashBytes(std::span(bytes).first(bytes.size() - 7)));
+	}
+}
+
+
+// === ImpHash::StripeHasher ===========================================================================================
+
+TEST(StripeHasher, AllSizes)
+{
+	const std::vector<std::byte> bytes = BF::MakeRandomBytes(3000, 11);
+
+	std::unordered_set<UInt64> hashes;
+	for (std::size_t size = BF::ImpHash::StripeHasher::MinSize; size <= bytes.size(); size++)
+		hashes.insert(BF::ImpHash::StripeHasher::Hash(bytes.data(), size));
+
+	EXPECT_EQ(hashes.size(), bytes.size() + 1 - BF::ImpHash::StripeHasher::MinSize);
+}
+
+
+TEST(StripeHasher, EveryByteMatters)
+{
+	for (std::size_t size : { 256, 1000, 1024, 1025, 4096 }) {
+		std::vector<std::byte> bytes = BF::MakeRandomBytes(size, size);
+		const UInt64           hash  = BF::ImpHash::StripeHasher::Hash(bytes.data(), size);
+
+		std::unordered_set<UInt64> hashes = { hash };
+		for (std::size_t i = 0; i < size; i++) {
+			bytes[i] ^= std::byte(1 << (i % 8));
+			hashes.insert(BF::ImpHash::StripeHasher::Hash(bytes.data(), size));
+			bytes[i] ^= std::byte(1 << (i % 8));
+		}
+
+		EXPECT_EQ(hashes.size(), size + 1) << "size: " << size;
+	}
+}
+
+
+TEST(StripeHasher, SameWithAndWithoutAVX2)
+{
+	const std::vector<std::byte> bytes = BF::MakeRandomBytes(2000, 13);
+
+	EXPECT_EQ(BF::ImpHash::StripeHasher::Hash(bytes.data(), 256),         0x28940e0f9026599c);
+	EXPECT_EQ(BF::ImpHash::StripeHasher::Hash(bytes.data(), 1999),        0xb6455c288154e093);
+	EXPECT_EQ(BF::ImpHash::StripeHasher::Hash(bytes.data(), 2000, 12345), 0xbef294ae11c08425);
+
+	for (std::size_t size = BF::ImpHash::StripeHasher::MinSize; size <= bytes.size(); size += 7) {
+		EXPECT_EQ(BF::ImpHash::StripeHasher::Hash(bytes.data(), size, size),
+				  BF::ImpHash::StripeHasher::HashScalar(bytes.data(), size, size)) << "size: " << size;
+	}
+
+	EXPECT_EQ(BF::HashBytes(bytes), BF::ImpHash::StripeHasher::Hash(bytes.data(), bytes.size()));
+}
+
+
+// === HashRawMemory ===================================================================================================
+
+TEST(HashBytes, HashRawMemory)
+{
+	std::vector<std::byte> bytes = BF::MakeRandomBytes(1 << 20, 5);
+	const std::size_t      hash  = std::hash<BF::HashRawMemory<std::dynamic_extent>>()(BF::HashRawMemory(bytes.data(), bytes.size()));
+
+	EXPECT_EQ(hash, BF::HashBytes(bytes));
+
+	bytes[(1 << 19) + 12345] ^= std::byte(1);							// the whole buffer is hashed, not a sample
+	EXPECT_NE(std::hash<BF::HashRawMemory<std::dynamic_extent>>()(BF::HashRawMemory(bytes.data(), bytes.size())), hash);
+}
+
+
+}	// namespace
@@ -0,0 +1,107 @@
+#include "BF/HashFile.hpp"
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BF/TestUtils.hpp"
+
+
+namespace {
+
+
+using BF::ImpHash::TreeLeafSize;
+
+
+// Writes a file in the temp directory, and deletes it at the end of the test.
+class TempFile {
+public:
+	TempFile(const std::string& name, std::span<const std::byte> bytes) :
+		mPath(std::filesystem::temp_directory_path() / ("BFTest_HashFile_" + name))
+	{
+		std::ofstream file(mPath, std::ios::binary);
+		file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	}
+
+	~TempFile() {
+		std::error_code error;
+		std::filesystem::remove(mPath, error);
+	}
+
+	const std::filesystem::path& GetPath() const {
+		return mPath;
+	}
+
+private:
+	std::filesystem::path mPath;
+};
+
+
+// === Usage example ===================================================================================================
+
+TEST(HashFile, Usage)
+{
+	const std::vector<std::byte> bytes = BF::MakeRandomBytes(1 << 20, 1);
+	const TempFile               file("Usage", bytes);
+
+	const std::optional<UInt64> hash = BF::HashFile(file.GetPath());		// e.g. compared to a stored fingerprint
+	ASSERT_TRUE(hash.has_value());
+	EXPECT_EQ(*hash, BF::TreeHash(bytes));
+}
+
+
+// === HashFile() ======================================================================================================
+
+TEST(HashFile, Sizes)
+{
+	const std::vector<std::byte> bytes = BF::MakeRandomBytes(3 * TreeLeafSize + 5, 2);
+
+	for (std::size_t size : { std::size_t(0), std::size_t(1), std::size_t(1000), TreeLeafSize, bytes.size() }) {
+		const std::span<const std::byte> content = std::span(bytes).first(size);
+		const TempFile                   file("Sizes_" + std::to_string(size), content);
+
+		EXPECT_EQ(BF::HashFile(file.GetPath()), BF::TreeHash(content)) << "size: " << size;
+		EXPECT_EQ(BF::HashFile(file.GetPath(), 1), BF::TreeHash(content)) << "size: " << size;
+		EXPECT_EQ(BF::ImpHash::HashFileByReading(file.GetPath()), BF::TreeHash(content)) << "size: " << size;
+	}
+}
+
+
+TEST(HashFile, Contents)
+{
+	std::vector<std::byte> bytes = BF::MakeRandomBytes(2 * TreeLeafSize, 3);
+	const TempFile         file1("Contents1", bytes);
+
+	bytes[TreeLeafSize + 10] ^= std::byte(1);
+	const TempFile file2("Contents2", bytes);
+
+	EXPECT_NE(BF::HashFile(file1.GetPath()), BF::HashFile(file2.GetPath()));
+}
+
+
+TEST(HashFile, Stable)
+{
+	const std::vector<std::byte> bytes = BF::MakeRandomBytes(3 * TreeLeafSize + 5, 20);
+	const TempFile               file("Stable", bytes);
+
+	// The same in every build and on every CPU, with and without AVX2. If they change, stored fingerprints are invalid.
+	EXPECT_EQ(BF::TreeHash(std::span(bytes).first(0)),        0xba59cfb56daa4056);
+	EXPECT_EQ(BF::TreeHash(std::span(bytes).first(100)),      0x5daee9d71846543c);
+	EXPECT_EQ(BF::TreeHash(std::span(bytes).first(5000)),     0xf87571943bc6ebf5);
+	EXPECT_EQ(BF::TreeHash(bytes),                            0xf7a1075dae71d310);
+	EXPECT_EQ(BF::HashFile(file.GetPath()),                   0xf7a1075dae71d310);
+	EXPECT_EQ(BF::ImpHash::HashFileByReading(file.GetPath()), 0xf7a1075dae71d310);
+}
+
+
+TEST(HashFile, Errors)
+{
+	const std::filesystem::path missing = std::filesystem::temp_directory_path() / "BFTest_HashFile_Missing";
+
+	EXPECT_EQ(BF::HashFile(missing), std::nullopt);
+	EXPECT_EQ(BF::ImpHash::HashFileByReading(missing), std::nullopt);
+	EXPECT_EQ(BF::HashFile(std::filesystem::temp_directory_path()), std::nullopt);	// a directory
+}
+
+
+}	// namespace
@@ -1,8 +1,19 @@
 #include "BF/HashRange.hpp"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <forward_list>
 #include <list>
+#include <random>
+#include <set>
+#include <string>
 #include <string_view>
+#include <unordered_set>
 #include <vector>
+#include "gtest/gtest.h"
 #include "BF/TestUtils.hpp"
 
 
@@ -74,14 +85,16 @@ BF_COMPILE_TIME_TEST()
 	TestHashRange<const std::vector<int>,             DoHash>();
 	TestHashRange<std::basic_string_view<char>,       DoHash>();
 	TestHashRange<std::basic_string_view<const char>, DoHash>();
+	TestHashRange<std::list<int>,                     DoHash>();
+	TestHashRange<std::forward_list<int>,             DoHash>();
+	TestHashRange<std::set<int>,                      DoHash>();
 
 	static_assert(std::is_final_v<BF::HashRange<int[7]>>);
 	static_assert(std::is_final_v<BF::HashRange<std::vector<int>>>);
 
-//	TestHashRange<int>();									// [CompilationError]: 'Range' must be a random access range.
-//	TestHashRange<const int>();								// [CompilationError]: 'Range' must be a random access range.
-//	TestHashRange<volatile int>();							// [CompilationError]: 'Range' must be a random access range.
-//	TestHashRange<std::list<int>>();						// [CompilationError]: 'Range' must be a random access range.
+//	TestHashRange<int>();									// [CompilationError]: 'Range' must be a forward range.
+//	TestHashRange<const int>();								// [CompilationError]: 'Range' must be a forward range.
+//	TestHashRange<volatile int>();							// [CompilationError]: 'Range' must be a forward range.
 //	TestHashRange<volatile std::vector<int>>();				// [CompilationError]: 'Range' must be a decayed type or a C array.
 //	TestHashRange<volatile int[7]>();						// [CompilationError]: 'Range' element type must be a (possibly const) decayed type.
 //	TestHashRange<int[7][77]>();							// [CompilationError]: 'Range' element type must be a (possibly const) decayed type.
@@ -131,4 +144,287 @@ BF_COMPILE_TIME_TEST()
 }
 
 
+// === GetRangeHash(): combinators =====================================================================================
+
+TEST(HashRange, GetRangeHashCombinator)
+{
+	std::vector<UInt64> shortRange(7,  64);
+	std::vector<UInt64> longRange (77, 64);			// all elements are equal, so the sampled positions don't matter
+
+	EXPECT_EQ(BF::ImpHash::GetRangeHash<BF::Avalanche<>>(shortRange), BF::FMix64(BF::ImpHash::GetRangeHash(shortRange)));
+	EXPECT_EQ(BF::ImpHash::GetRangeHash<BF::Avalanche<>>(longRange),  BF::FMix64(BF::ImpHash::GetRangeHash(longRange)));
+	EXPECT_NE(BF::ImpHash::GetRangeHash<BF::WideMulCombinator>(longRange), BF::ImpHash::GetRangeHash(longRange));
+}
+
+
+// === class HashRange: HashAll ========================================================================================
+
+static_assert(std::is_same_v<decltype(BF::HashRange(std::declval<const std::vector<int>&>())),                  BF::HashRange<std::vector<int>>>);
+static_assert(std::is_same_v<decltype(BF::HashRange(std::declval<const std::vector<int>&>(), BF::HashAll())), BF::HashRange<std::vector<int>, BF::HashAll>>);
+// BF::HashRange<std::vector<int>, int> BF_DUMMY;							// [CompilationError]: 'Mode' must be a 'HashSampleWith<Sampler>' or 'HashAll'.
+
+
+template <class Range>
+std::size_t HashAll(const Range& range)
+{
+	return std::hash<BF::HashRange<Range, BF::HashAll>>()(BF::HashRange(range, BF::HashAll()));
+}
+
+
+template <class Range>
+std::size_t HashSample(const Range& range)
+{
+	return std::hash<BF::HashRange<Range>>()(BF::HashRange(range));
+}
+
+
+TEST(HashRange, HashAllMiddleDifferences)
+{
+	std::vector<UInt32>      ints(10'000);
+	std::vector<std::string> strings(1'000);
+	std::deque<UInt32>       deque(1'000);
+
+	std::unordered_set<std::size_t> sampledHashes;
+	std::unordered_set<std::size_t> allHashes;
+	for (std::size_t i = 0; i < 1'000; i++) {						// keys which differ in a single middle element
+		ints[ints.size() / 2]       = static_cast<UInt32>(i);
+		strings[strings.size() / 2] = std::to_string(i);
+		deque[deque.size() / 2]     = static_cast<UInt32>(i);
+
+		sampledHashes.insert(HashSample(ints));
+		allHashes.insert(HashAll(ints));
+		allHashes.insert(HashAll(strings));
+		allHashes.insert(HashAll(deque));
+	}
+
+	EXPECT_LT(sampledHashes.size(), 10u);
+	EXPECT_EQ(allHashes.size(), 3'000u);
+}
+
+
+TEST(HashRange, HashAllModes)
+{
+	const std::vector<UInt16>   ints  = { 1, 2, 3 };
+	const std::array<UInt16, 3> array = { 1, 2, 3 };
+	const std::deque<UInt16>    deque = { 1, 2, 3 };
+
+	// Contiguous ranges of integers are hashed as bytes, other ranges element by element.
+	EXPECT_EQ(HashAll(ints), HashAll(array));
+	EXPECT_EQ(HashAll(ints), BF::FNV1aCombinator::Single(BF::HashBytes(std::as_bytes(std::span(ints)))));
+	EXPECT_EQ(HashAll(deque), std::hash<BF::Hash>()(BF::Hash(UInt16(1), UInt16(2), UInt16(3), BF::Hash::FromValue(3))));
+
+	EXPECT_EQ(BF::ImpHash::GetFullRangeHash<BF::Avalanche<>>(ints), BF::FMix64(HashAll(ints)));
+	EXPECT_EQ(BF::ImpHash::GetFullRangeHash<BF::Avalanche<>>(deque), BF::FMix64(HashAll(deque)));
+}
+
+
+// === class HashRange: forward ranges =================================================================================
+
+TEST(HashRange, ForwardRanges)
+{
+	for (std::size_t size : { 0, 1, 16, 17, 100, 1000 }) {
+		std::vector<int> vec(size);
+		for (std::size_t i = 0; i < size; i++)
+			vec[i] = static_cast<int>(i * 7 % 13);
+
+		const std::list<int> list(vec.begin(), vec.end());
+		const auto           view = std::views::iota(0, static_cast<int>(size)) | std::views::transform([](int i) { return i * 7 % 13; });
+
+		EXPECT_EQ(HashSample(list), HashSample(vec)) << "size: " << size;	// the same positions are sampled
+		EXPECT_EQ(HashSample(view), HashSample(vec)) << "size: " << size;
+		EXPECT_EQ((BF::ImpHash::GetRangeHash<BF::FNV1aCombinator, BF::LogSampler>(list)), (BF::ImpHash::GetRangeHash<BF::FNV1aCombinator, BF::LogSampler>(vec)));
+		EXPECT_EQ(HashAll(list), HashAll(std::deque<int>(vec.begin(), vec.end())));
+	}
+}
+
+
+TEST(HashRange, UnsizedRanges)
+{
+	const std::forward_list<int> list = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20 };
+
+	BF::ImpHash::HashCombinator<BF::FNV1aCombinator> hc;		// all elements, then the count
+	for (int value : list)
+		hc.Add(value);
+
+	hc.Add(UInt64(20));
+
+	EXPECT_EQ(HashSample(list), hc.Get());
+	EXPECT_EQ(HashAll(list), HashAll(std::deque<int>(list.begin(), list.end())));
+
+	std::forward_list<int> middle = list;
+	*std::next(middle.begin(), 10) = 0;						// every element is hashed, not a sample
+	EXPECT_NE(HashSample(middle), HashSample(list));
+}
+
+
+// === Sampling policies ===============================================================================================
+
+static_assert(BF::RangeSamplingPolicy<BF::RanluxSampler>);
+static_assert(BF::RangeSamplingPolicy<BF::SplitMixSampler>);
+static_assert(BF::RangeSamplingPolicy<BF::StrideSampler>);
+static_assert(BF::RangeSamplingPolicy<BF::LogSampler>);
+static_assert(!BF::RangeSamplingPolicy<BF::HashSample>);					// a mode, not a sampler
+static_assert(!BF::RangeSamplingPolicy<BF::HashAll>);
+
+
+struct NoSamples : BF::StrideSampler {
+	using StrideSampler::StrideSampler;
+	constexpr static UInt64 GetSampleCount(UInt64) { return 0; }
+};
+
+static_assert(!BF::RangeSamplingPolicy<NoSamples>);						// the interior is divided by the count
+
+
+// The modes select the samplers.
+static_assert(std::is_same_v<BF::HashSample::Sampler, BF::RanluxSampler>);
+static_assert(std::is_same_v<BF::HashSampleLog::Sampler, BF::LogSampler>);
+static_assert(std::is_same_v<decltype(BF::HashRange(std::declval<const std::vector<int>&>(), BF::HashSample())), BF::HashRange<std::vector<int>>>);
+static_assert(std::is_same_v<decltype(BF::HashRange(std::declval<const std::vector<int>&>(), BF::HashSampleLog())), BF::HashRange<std::vector<int>, BF::HashSampleLog>>);
+static_assert(std::is_same_v<BF::HashSampleWith<BF::StrideSampler>, BF::HashSampleStride>);
+// BF::HashRange<std::vector<int>, BF::LogSampler> BF_DUMMY;				// [CompilationError]: 'Mode' must be a 'HashSampleWith<Sampler>' or 'HashAll'.
+
+
+// Records the absorbed elements instead of hashing them.
+struct RecordingState {
+	void Add(const auto&... values) { ( ..., added.push_back(static_cast<UInt64>(values)) ); }
+	UInt64 Get() const              { return added.size(); }
+
+	std::vector<UInt64> added;
+};
+
+
+template <class Sampler>
+std::vector<UInt64> GetSampledElements(std::size_t size)
+{
+	std::vector<UInt64> range(size);
+	for (std::size_t i = 0; i < size; i++)
+		range[i] = i;
+
+	RecordingState state;
+	BF::ImpHash::AddRangeSample<Sampler>(state, range);
+
+	RecordingState listState;											// walked, but at the same positions
+	BF::ImpHash::AddRangeSample<Sampler>(listState, std::list<UInt64>(range.begin(), range.end()));
+	EXPECT_EQ(listState.added, state.added);
+
+	return { state.added.begin() + 1, state.added.end() };			// without the size
+}
+
+
+template <class Sampler>
+void TestSampler(UInt64 expectedCountFor1000)
+{
+	for (std::size_t size : { 0, 1, 16 })
+		EXPECT_EQ(GetSampledElements<Sampler>(size).size(), size);
+
+	for (std::size_t size : { 17, 18, 23, 24, 25, 100, 1000, 12345 }) {
+		const std::vector<UInt64> sampled = GetSampledElements<Sampler>(size);
+		const std::size_t         count   = std::min<std::size_t>(Sampler::GetSampleCount(size), size - 8);
+
+		ASSERT_EQ(sampled.size(), 8 + count);
+		for (std::size_t i = 8; i + 1 < sampled.size(); i++)		// one element from each interval, in order
+			EXPECT_LT(sampled[i], sampled[i + 1]);
+
+		EXPECT_GE(sampled[8], 4u);
+		EXPECT_LT(sampled.back(), size - 4);
+	}
+
+	EXPECT_EQ(GetSampledElements<Sampler>(1000).size(), 8 + expectedCountFor1000);
+	EXPECT_EQ(GetSampledElements<Sampler>(1000), GetSampledElements<Sampler>(1000));		// deterministic
+}
+
+
+TEST(HashRange, SamplingPolicies)
+{
+	TestSampler<BF::RanluxSampler>(8);
+	TestSampler<BF::SplitMixSampler>(8);
+	TestSampler<BF::StrideSampler>(8);
+	TestSampler<BF::LogSampler>(20);
+
+	EXPECT_EQ(BF::LogSampler::GetSampleCount(10'000'000), 48u);
+}
+
+
+template <class Mode>
+std::size_t CountDistinctHashes(std::size_t size)
+{
+	std::vector<UInt32>             range(size);
+	std::unordered_set<std::size_t> hashes;
+
+	for (std::size_t i = 0; i < size; i++) {						// keys which differ in a single element
+		range[i] = 1;
+		using Key = BF::HashRange<std::vector<UInt32>, Mode>;
+		hashes.insert(std::hash<Key>()(Key(range)));
+		range[i] = 0;
+	}
+
+	return hashes.size();
+}
+
+
+TEST(HashRange, SamplingPolicyCollisions)
+{
+	constexpr std::size_t Size = 1000;
+
+	// Every key has 8 + 'GetSampleCount()' hashed elements out of 'Size', the rest collide with each other.
+	EXPECT_LT(CountDistinctHashes<BF::HashSample>(Size),         Size / 10);
+	EXPECT_LT(CountDistinctHashes<BF::HashSampleSplitMix>(Size), Size / 10);
+	EXPECT_EQ(CountDistinctHashes<BF::HashSampleStride>(Size),   8u + 8 + 1);
+	EXPECT_GT(CountDistinctHashes<BF::HashSampleLog>(Size),      CountDistinctHashes<BF::HashSampleStride>(Size));
+}
+
+
+// === Benchmark =======================================================================================================
+// Not run by default, run it with '--gtest_also_run_disabled_tests --gtest_filter=*SamplingBenchmark'. For every
+// sampling mode and range size, it prints the time of one hash, and the collision rate of keys which differ in a single
+// element at a random position.
+
+template <class Mode>
+void BenchmarkSampling(const char* modeName)
+{
+	using Key = BF::HashRange<std::vector<UInt32>, Mode>;
+
+	constexpr std::size_t HashCount = 100'000;
+	constexpr std::size_t KeyCount  = 10'000;
+
+	std::mt19937_64 random(1);
+
+	for (std::size_t size : { 16, 100, 1'000, 10'000, 100'000, 1'000'000, 10'000'000 }) {
+		std::vector<UInt32> range(size);
+
+		std::size_t sink  = 0;
+		const auto  start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < HashCount; i++) {
+			range[0] = static_cast<UInt32>(sink);						// the hash can't be hoisted out of the loop
+			sink    += std::hash<Key>()(Key(range));
+		}
+
+		const std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+
+		range[0] = 0;
+		std::unordered_set<std::size_t> hashes;
+		for (std::size_t i = 0; i < KeyCount; i++) {					// distinct keys: the values are distinct
+			const std::size_t position = random() % size;
+			range[position] = static_cast<UInt32>(i + 1);
+			hashes.insert(std::hash<Key>()(Key(range)));
+			range[position] = 0;
+		}
+
+		const double collisionRate = 1.0 - static_cast<double>(hashes.size()) / KeyCount;
+		std::printf("%-20s %10zu elements %10.1f ns/hash %6.1f%% collisions\n", modeName, size,
+					time.count() / HashCount, 100 * collisionRate);
+		EXPECT_NE(sink, 0u);
+	}
+}
+
+
+TEST(HashRange, DISABLED_SamplingBenchmark)
+{
+	BenchmarkSampling<BF::HashSample>        ("HashSample");
+	BenchmarkSampling<BF::HashSampleSplitMix>("HashSampleSplitMix");
+	BenchmarkSampling<BF::HashSampleStride>  ("HashSampleStride");
+	BenchmarkSampling<BF::HashSampleLog>     ("HashSampleLog");
+}
+
+
 }	// namespace
@@ -0,0 +1,115 @@
+#include "BF/HashState.hpp"
+
+#include <list>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BF/TestUtils.hpp"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+struct Part {
+	bool operator==(const Part&) const = default;
+
+	void BF_HashInto(BF::HashState& state) const { state.Add(mId).AddRange(mNames); }
+	BF::Hash BF_GetHash() const                  { return BF::HashState().Add(*this).GetHash(); }
+
+	UInt32                   mId;
+	std::vector<std::string> mNames;
+};
+
+
+struct Composite {
+	bool operator==(const Composite&) const = default;
+
+	void BF_HashInto(BF::HashState& state) const { state.Add(mName).AddRange(mParts).AddBytes(std::as_bytes(std::span(mBlob))); }
+	BF::Hash BF_GetHash() const                  { return BF::HashState().Add(*this).GetHash(); }
+
+	std::string       mName;
+	std::list<Part>   mParts;							// nested 'BF_HashInto()' calls, no 'std::size_t' per 'Part'
+	std::vector<char> mBlob;
+};
+
+
+BF_COMPILE_TIME_TEST()
+{
+	std::unordered_set<Composite> BF_DUMMY;
+}
+
+
+// === class BasicHashState ============================================================================================
+
+static_assert(std::is_same_v<BF::HashState, BF::BasicHashState<BF::FNV1aCombinator>>);
+
+
+TEST(HashState, Add)
+{
+	EXPECT_EQ(std::hash<Part>()({ 1, {} }), std::hash<Part>()({ 1, {} }));
+	EXPECT_NE(std::hash<Part>()({ 1, {} }), std::hash<Part>()({ 2, {} }));
+	EXPECT_NE(std::hash<Part>()({ 1, { "a" } }), std::hash<Part>()({ 1, { "b" } }));
+	EXPECT_NE(std::hash<Part>()({ 1, { "a", "b" } }), std::hash<Part>()({ 1, { "b", "a" } }));
+}
+
+
+TEST(HashState, AddHash)
+{
+	BF::FNV1aCombinator expected;
+	expected.Add(std::hash<int>()(7));
+	expected.Add(456);													// the stored value, not rehashed
+
+	const BF::Hash hash = BF::HashState().Add(7, BF::Hash::FromValue(456)).GetHash();
+	EXPECT_EQ(std::hash<BF::Hash>()(hash), expected.Get());
+}
+
+
+TEST(HashState, AddRange)
+{
+	std::vector<int> vector = { 1, 2, 3 };
+	std::list<int>   list   = { 1, 2, 3 };
+
+	BF::HashState fromVector, fromList, fromValues, differentSize;
+	fromVector.AddRange(vector);
+	fromList.AddRange(list);
+	fromValues.Add(1, 2, 3);
+	differentSize.AddRange(vector).AddRange(std::vector<int>());
+
+	EXPECT_EQ(std::hash<BF::Hash>()(fromVector.GetHash()), std::hash<BF::Hash>()(fromList.GetHash()));
+	EXPECT_NE(std::hash<BF::Hash>()(fromVector.GetHash()), std::hash<BF::Hash>()(fromValues.GetHash()));	// the size is absorbed too
+	EXPECT_NE(std::hash<BF::Hash>()(fromVector.GetHash()), std::hash<BF::Hash>()(differentSize.GetHash()));
+}
+
+
+TEST(HashState, AddBytes)
+{
+	const auto getBytesHash = [](std::string_view str) {
+		return std::hash<BF::Hash>()(BF::HashState().AddBytes(std::as_bytes(std::span(str))).GetHash());
+	};
+
+	std::unordered_set<std::size_t> hashes;
+	for (std::size_t size = 0; size <= 20; size++)
+		hashes.insert(getBytesHash(std::string(size, '\0')));		// only the size differs
+
+	EXPECT_EQ(hashes.size(), 21u);
+	EXPECT_EQ(getBytesHash("0123456789abcdefX"), getBytesHash("0123456789abcdefX"));
+	EXPECT_NE(getBytesHash("0123456789abcdefX"), getBytesHash("0123456789abcdefY"));
+}
+
+
+TEST(HashState, Composite)
+{
+	const Composite c1 = { "c", { { 1, { "a" } }, { 2, { "b" } } }, { 'x' } };
+	Composite       c2 = c1;
+
+	EXPECT_EQ(std::hash<Composite>()(c1), std::hash<Composite>()(c2));
+
+	c2.mParts.back().mNames.push_back("c");
+	EXPECT_NE(std::hash<Composite>()(c1), std::hash<Composite>()(c2));
+}
+
+
+}	// namespace
@@ -0,0 +1,67 @@
+#include "BF/HyperLogLog.hpp"
+
+#include <string>
+#include "gtest/gtest.h"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+struct Event {
+	BF::Hash BF_GetHash() const { return { mUserId, std::string_view(mPage) }; }
+
+	UInt64      mUserId;
+	std::string mPage;
+};
+
+
+TEST(HyperLogLog, Usage)
+{
+	BF::HyperLogLog<Event> distinctEvents;
+	for (int repeat = 0; repeat < 3; repeat++) {
+		for (UInt64 user = 0; user < 1000; user++)
+			distinctEvents.Insert({ user, "index.html" });
+	}
+
+	EXPECT_NEAR(distinctEvents.Estimate(), 1000, 1000 * 0.05);
+}
+
+
+// === class HyperLogLog ===============================================================================================
+
+TEST(HyperLogLog, Estimate)
+{
+	BF::HyperLogLog<UInt64> hll;
+	EXPECT_EQ(hll.Estimate(), 0);
+
+	UInt64 count = 0;
+	for (const UInt64 target : { 10, 100, 10'000, 1'000'000 }) {
+		for (; count < target; count++)
+			hll.Insert(count);
+
+		EXPECT_NEAR(hll.Estimate(), double(target), double(target) * 0.04);		// 5 standard errors
+	}
+}
+
+
+TEST(HyperLogLog, Merge)
+{
+	BF::HyperLogLog<UInt64, std::hash<UInt64>, 12> all, first, second;
+	for (UInt64 i = 0; i < 100'000; i++) {
+		all.Insert(i);
+		(i < 60'000 ? first : second).Insert(i);
+		if (i % 2 == 0)
+			second.Insert(i);										// overlapping
+	}
+
+	first.Merge(second);
+	EXPECT_EQ(first.Estimate(), all.Estimate());
+
+	first.Clear();
+	EXPECT_EQ(first.Estimate(), 0);
+}
+
+
+}	// namespace
@@ -0,0 +1,103 @@
+#include "BF/InternPool.hpp"
+
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "gtest/gtest.h"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+TEST(InternPool, Usage)
+{
+	BF::InternPool pool;
+
+	const BF::InternedString a1 = pool.Intern("alpha");
+	const BF::InternedString a2 = pool.Intern(std::string("alp") + "ha");
+	const BF::InternedString b  = pool.Intern("beta");
+
+	EXPECT_EQ(a1, a2);												// a pointer comparison
+	EXPECT_NE(a1, b);
+	EXPECT_EQ(a1.GetView(), "alpha");
+	EXPECT_STREQ(b.GetCStr(), "beta");
+	EXPECT_EQ(pool.GetSize(), 2u);
+
+	std::unordered_map<BF::InternedString, int> counts;				// hashing uses the precomputed hash
+	counts[a1]++;
+	counts[a2]++;
+	EXPECT_EQ(counts[a1], 2);
+}
+
+
+// === class InternedString ============================================================================================
+
+static_assert(std::is_trivially_copyable_v<BF::InternedString>);
+static_assert(sizeof(BF::InternedString) == sizeof(void*));
+
+
+TEST(InternPool, Hash)
+{
+	BF::InternPool pool;
+
+	for (const std::string_view str : { "", "x", "identifier", "a somewhat longer identifier string" }) {
+		const BF::InternedString interned = pool.Intern(str);
+		EXPECT_EQ(interned.GetView(), str);
+		EXPECT_EQ(std::hash<BF::InternedString>()(interned), BF::HashBytes(std::as_bytes(std::span(str))));
+	}
+
+	EXPECT_EQ(pool.Intern(""), BF::InternedString());
+	EXPECT_EQ(pool.GetSize(), 3u);
+}
+
+
+// === class InternPool ================================================================================================
+
+TEST(InternPool, Find)
+{
+	BF::InternPool pool;
+	const BF::InternedString id = pool.Intern("id");
+
+	EXPECT_EQ(pool.Find("id"), id);
+	EXPECT_EQ(pool.Find("missing"), std::nullopt);
+	EXPECT_EQ(pool.GetSize(), 1u);
+}
+
+
+TEST(InternPool, Threads)
+{
+	constexpr int ThreadCount = 8;
+	constexpr int StringCount = 10'000;
+
+	BF::InternPool                             pool;
+	std::vector<std::vector<BF::InternedString>> results(ThreadCount);
+
+	{
+		std::vector<std::jthread> threads;
+		for (int t = 0; t < ThreadCount; t++) {
+			threads.emplace_back([&, t] {
+				for (int i = 0; i < StringCount; i++)				// every thread interns the same strings
+					results[t].push_back(pool.Intern("string" + std::to_string((i * 7 + t * 13) % StringCount)));
+			});
+		}
+	}
+
+	EXPECT_EQ(pool.GetSize(), std::size_t(StringCount));
+
+	for (int t = 0; t < ThreadCount; t++) {
+		for (int i = 0; i < StringCount; i++) {
+			const std::string expected = "string" + std::to_string((i * 7 + t * 13) % StringCount);
+			ASSERT_EQ(results[t][i].GetView(), expected);
+			ASSERT_EQ(results[t][i], pool.Find(expected));
+		}
+	}
+
+	const std::string longString(100'000, 'x');						// larger than an arena block
+	EXPECT_EQ(pool.Intern(longString).GetView(), longString);
+}
+
+
+}	// namespace
@@ -0,0 +1,115 @@
+#include "BF/MerkleHash.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+TEST(MerkleHash, Usage)
+{
+	std::vector<char> document(100'000, 'a');
+	BF::MerkleHash    hash(document);									// 4096 character blocks
+	const UInt64      original = hash.GetRoot();
+
+	document[12345] = 'x';
+	hash.Update(document, 12345, 1);
+	EXPECT_NE(hash.GetRoot(), original);
+
+	const BF::MerkleHash replica(std::vector<char>(100'000, 'a'));
+	EXPECT_EQ(hash.Diff(replica), std::vector<std::size_t>{ 12345 / 4096 });
+}
+
+
+// === class MerkleHash ================================================================================================
+
+TEST(MerkleHash, UpdateSameAsRebuild)
+{
+	std::mt19937_64 random(1);
+
+	for (std::size_t size : { 1, 7, 64, 100, 1000, 12345 }) {
+		for (std::size_t blockSize : { 1, 3, 16, 100, 4096 }) {
+			std::vector<UInt32>    elements(size);
+			BF::MerkleHash<UInt32> hash(elements, blockSize);
+
+			for (int edit = 0; edit < 20; edit++) {
+				const std::size_t first = random() % size;
+				const std::size_t count = random() % (size - first + 1);
+				for (std::size_t i = first; i < first + count; i++)
+					elements[i] = static_cast<UInt32>(random());
+
+				hash.Update(elements, first, count);
+				ASSERT_EQ(hash.GetRoot(), BF::MerkleHash<UInt32>(elements, blockSize).GetRoot())
+					<< "size: " << size << ", block size: " << blockSize;
+			}
+		}
+	}
+}
+
+
+TEST(MerkleHash, Blocks)
+{
+	std::vector<UInt8> bytes(1000);
+	for (std::size_t i = 0; i < bytes.size(); i++)
+		bytes[i] = static_cast<UInt8>(i);
+
+	const BF::MerkleHash<UInt8> hash(bytes, 300);
+	ASSERT_EQ(hash.GetBlockCount(), 4u);
+	EXPECT_EQ(hash.GetBlockSize(), 300u);
+	EXPECT_EQ(hash.GetBlockHash(0), BF::HashBytes(std::as_bytes(std::span(bytes).first(300))));
+	EXPECT_EQ(hash.GetBlockHash(3), BF::HashBytes(std::as_bytes(std::span(bytes).subspan(900))));		// shorter
+}
+
+
+TEST(MerkleHash, Root)
+{
+	const std::vector<UInt32> empty;
+	const std::vector<UInt32> zero(1);
+	const std::vector<UInt32> zeros(2);
+
+	EXPECT_EQ(BF::MerkleHash(empty).GetRoot(), BF::MerkleHash(empty).GetRoot());
+	EXPECT_EQ(BF::MerkleHash(empty).GetBlockCount(), 0u);
+	EXPECT_NE(BF::MerkleHash(empty).GetRoot(), BF::MerkleHash(zero).GetRoot());
+	EXPECT_NE(BF::MerkleHash(zero).GetRoot(), BF::MerkleHash(zeros).GetRoot());
+	EXPECT_NE(BF::MerkleHash(zeros, 1).GetRoot(), BF::MerkleHash(zeros, 2).GetRoot());		// the shape is hashed too
+}
+
+
+TEST(MerkleHash, Diff)
+{
+	std::vector<UInt64> elements(10'000);
+	const BF::MerkleHash<UInt64> original(elements, 100);
+	BF::MerkleHash<UInt64>       modified(elements, 100);
+
+	EXPECT_TRUE(modified.Diff(original).empty());
+
+	for (std::size_t i : { 0, 250, 5'000, 5'099, 9'999 }) {
+		elements[i] = 1;
+		modified.Update(elements, i, 1);
+	}
+
+	const std::vector<std::size_t> expected = { 0, 2, 50, 99 };
+	EXPECT_EQ(modified.Diff(original), expected);
+	EXPECT_EQ(original.Diff(modified), expected);
+
+	for (std::size_t i : { 0, 250, 5'000, 5'099, 9'999 }) {				// back to the original
+		elements[i] = 0;
+		modified.Update(elements, i, 1);
+	}
+
+	EXPECT_TRUE(modified.Diff(original).empty());
+	EXPECT_EQ(modified.GetRoot(), original.GetRoot());
+}
+
+
+static_assert(BF::MerkleHash<char>::DefaultBlockSize == 4096);
+static_assert(BF::MerkleHash<UInt64>::DefaultBlockSize == 512);
+// BF::MerkleHash<std::string> BF_DUMMY(std::span<const std::string>());		// [CompilationError]: 'Type' must be hashable as bytes.
+
+
+}	// namespace
@@ -0,0 +1,147 @@
+#include "BF/RollingHash.hpp"
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BF/TestUtils.hpp"
+
+
+namespace {
+
+
+template <class Type>
+UInt64 GetWindowHash(std::span<const Type> window)
+{
+	BF::RollingHash<Type> hash(window.size());
+	for (const Type& value : window)
+		hash.Add(value);
+
+	return hash.Get();
+}
+
+
+// === Usage example ===================================================================================================
+
+TEST(RollingHash, Usage)
+{
+	const std::string_view text = "abcdefgh-abcdefgh";
+
+	BF::RollingHash<char> hash(8);
+	for (std::size_t i = 0; i < 8; i++)
+		hash.Add(text[i]);
+
+	const UInt64 first = hash.Get();							// "abcdefgh"
+	for (std::size_t i = 8; i < text.size(); i++)
+		hash.Roll(text[i - 8], text[i]);
+
+	EXPECT_EQ(hash.Get(), first);								// "abcdefgh" again
+}
+
+
+// === class RollingHash ===============================================================================================
+
+TEST(RollingHash, SameAsRecomputed)
+{
+	const std::vector<std::byte> bytes = BF::MakeRandomBytes(1000, 1, 4);		// few distinct values, so windows repeat
+
+	for (std::size_t windowSize : { 1, 2, 7, 31, 32, 48, 63, 64, 65, 100, 128, 200 }) {
+		BF::RollingHash hash(windowSize);
+		for (std::size_t i = 0; i < windowSize; i++)
+			hash.Add(bytes[i]);
+
+		EXPECT_TRUE(hash.IsFull());
+		EXPECT_EQ(hash.Get(), GetWindowHash(std::span(bytes).first(windowSize)));
+
+		for (std::size_t i = windowSize; i < bytes.size(); i++) {
+			hash.Roll(bytes[i - windowSize], bytes[i]);
+			ASSERT_EQ(hash.Get(), GetWindowHash(std::span(bytes).subspan(i - windowSize + 1, windowSize))) << "window: " << windowSize << ", end: " << i;
+		}
+	}
+}
+
+
+TEST(RollingHash, DistinctWindows)
+{
+	const std::vector<std::byte> bytes = BF::MakeRandomBytes(200, 2);
+
+	const std::size_t windowSize = 16;
+
+	BF::RollingHash            hash(windowSize);
+	std::unordered_set<UInt64> hashes;
+	for (std::size_t i = 0; i < bytes.size(); i++) {
+		if (i < windowSize) {
+			hash.Add(bytes[i]);
+		} else {
+			hash.Roll(bytes[i - windowSize], bytes[i]);
+		}
+
+		if (hash.IsFull())
+			hashes.insert(hash.Get());
+	}
+
+	EXPECT_EQ(hashes.size(), bytes.size() - windowSize + 1);
+}
+
+
+TEST(RollingHash, OrderMatters)
+{
+	const std::vector<std::byte> ab = { std::byte('a'), std::byte('b') };
+	const std::vector<std::byte> ba = { std::byte('b'), std::byte('a') };
+
+	EXPECT_NE(GetWindowHash<std::byte>(ab), GetWindowHash<std::byte>(ba));
+}
+
+
+TEST(RollingHash, Elements)
+{
+	const std::vector<std::string> words = { "a", "b", "c", "a", "b", "c", "d" };
+
+	BF::RollingHash<std::string> hash(3);
+	for (std::size_t i = 0; i < 3; i++)
+		hash.Add(words[i]);
+
+	const UInt64 abc = hash.Get();
+	hash.Roll(words[0], words[3]);
+	hash.Roll(words[1], words[4]);
+	hash.Roll(words[2], words[5]);
+	EXPECT_EQ(hash.Get(), abc);
+
+	hash.Roll(words[3], words[6]);
+	EXPECT_NE(hash.Get(), abc);
+	EXPECT_EQ(hash.Get(), GetWindowHash(std::span(words).subspan(4, 3)));
+}
+
+
+TEST(RollingHash, Clear)
+{
+	BF::RollingHash<char> hash(2);
+	hash.Add('x');
+	hash.Add('y');
+
+	const UInt64 xy = hash.Get();
+	hash.Clear();
+	EXPECT_FALSE(hash.IsFull());
+
+	hash.Add('x');
+	hash.Add('y');
+	EXPECT_EQ(hash.Get(), xy);
+	EXPECT_EQ(hash.GetWindowSize(), 2u);
+}
+
+
+static_assert([] {
+	BF::RollingHash<char> hash(2);
+	hash.Add('a');
+	hash.Add('b');
+	const UInt64 ab = hash.Get();
+
+	hash.Roll('a', 'a');
+	hash.Roll('b', 'b');
+	return hash.Get() == ab;
+}());
+
+
+}	// namespace
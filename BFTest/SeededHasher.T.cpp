@@ -0,0 +1,157 @@
+#include "BF/SeededHasher.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "gtest/gtest.h"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+TEST(SeededHasher, Usage)
+{
+	using Hasher = BF::SeededHasher<UInt64>;
+
+	std::unordered_map<UInt64, int, Hasher> map1;							// seeded by 'BF::GetProcessHashSeed()'
+	std::unordered_map<UInt64, int, Hasher> map2(16, Hasher(12345));		// its own seed
+
+	map1[1] = 1;
+	map2[1] = 2;
+	EXPECT_EQ(map1.at(1), 1);
+	EXPECT_EQ(map2.at(1), 2);
+	EXPECT_EQ(map1.hash_function().GetSeed(), BF::GetProcessHashSeed());
+	EXPECT_EQ(map2.hash_function().GetSeed(), 12345u);
+}
+
+
+// === class SeededHasher ==============================================================================================
+
+TEST(SeededHasher, Seeds)
+{
+	const BF::SeededHasher<UInt64> hasher1(1);
+	const BF::SeededHasher<UInt64> hasher2(2);
+
+	std::size_t differences = 0;
+	for (UInt64 i = 0; i < 1000; i++)
+		differences += hasher1(i) != hasher2(i);
+
+	EXPECT_EQ(differences, 1000u);
+}
+
+
+// Keys with a stride of 2^k, in a power of two sized table indexed with the low bits.
+TEST(SeededHasher, StridedKeys)
+{
+	constexpr std::size_t BucketCount = 1024;
+
+	const BF::SeededHasher<UInt64> hasher(7);
+	std::vector<std::size_t>       bucketLoads(BucketCount);
+
+	for (UInt64 i = 0; i < BucketCount; i++)
+		bucketLoads[hasher(i << 20) % BucketCount]++;
+
+	EXPECT_GT(BucketCount - std::ranges::count(bucketLoads, 0u), BucketCount / 2);	// 63% is expected
+	EXPECT_LT(std::ranges::max(bucketLoads), 12u);
+}
+
+
+TEST(SeededHasher, Ranges)
+{
+	const BF::SeededHasher<std::vector<int>> hasher1(1);
+	const BF::SeededHasher<std::vector<int>> hasher2(2);
+
+	std::vector<int> vec(100);
+	EXPECT_EQ(hasher1(vec), BF::ImpHash::GetRangeHash<BF::WideMulCombinator>(vec, 1));
+	EXPECT_NE(hasher1(vec), hasher2(vec));
+
+	std::unordered_set<std::vector<int>, BF::SeededHasher<std::vector<int>>> set;
+	set.insert(vec);
+	vec[0] = 1;
+	set.insert(vec);
+	EXPECT_EQ(set.size(), 2u);
+}
+
+
+// === Benchmark =======================================================================================================
+// Not run by default, run it with '--gtest_also_run_disabled_tests --gtest_filter=*SeededHasher*Benchmark'. Prints the
+// time of one insert and one find in an 'std::unordered_map' with 'std::hash' and with 'SeededHasher', for IDs with a
+// stride of 2^20, and for pairs which collide with FNV-1a (see 'CountDistinctHashesOfCollidingPairs()' in Hash.T.cpp).
+// The seed can't separate pairs whose 'std::hash' values are equal, only 'BF::SeededHash' members can.
+
+template <class HashType>
+struct Pair {
+	bool operator==(const Pair&) const = default;
+
+	HashType BF_GetHash() const { return { BF::Hash::FromValue(first), BF::Hash::FromValue(second) }; }
+
+	std::size_t first;
+	std::size_t second;
+};
+
+
+template <class HashType>
+std::vector<Pair<HashType>> MakeCollidingPairs(std::size_t count)
+{
+	constexpr std::size_t FNVOffsetBasis = 14695981039346656037u;
+	constexpr std::size_t FNVPrime       = 1099511628211;
+
+	std::vector<Pair<HashType>> pairs;
+	for (std::size_t a = 0; a < count; a++)
+		pairs.push_back({ a, ((FNVOffsetBasis ^ a) * FNVPrime) ^ 0x1234 });
+
+	return pairs;
+}
+
+
+template <class Hasher, class Key>
+void BenchmarkHasher(const char* name, const std::vector<Key>& keys)
+{
+	std::unordered_map<Key, int, Hasher> map;
+	std::size_t                          sink = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (const Key& key : keys)
+		map.emplace(key, 1);
+
+	const auto middle = std::chrono::steady_clock::now();
+	for (const Key& key : keys)
+		sink += map.count(key);
+
+	const std::chrono::duration<double, std::nano> insertTime = middle - start;
+	const std::chrono::duration<double, std::nano> findTime   = std::chrono::steady_clock::now() - middle;
+
+	std::printf("%-50s %9.1f ns insert %9.1f ns find\n", name, insertTime.count() / keys.size(),
+				findTime.count() / keys.size());
+	EXPECT_EQ(sink, keys.size());
+}
+
+
+TEST(SeededHasher, DISABLED_Benchmark)
+{
+	std::vector<UInt64> stridedKeys(1'000'000);
+	for (UInt64 i = 0; i < stridedKeys.size(); i++)
+		stridedKeys[i] = i << 20;
+
+	BenchmarkHasher<std::hash<UInt64>>       ("2^20 stride, std::hash",    stridedKeys);
+	BenchmarkHasher<BF::SeededHasher<UInt64>>("2^20 stride, SeededHasher", stridedKeys);
+
+	constexpr std::size_t PairCount = 10'000;						// a collision storm is quadratic
+
+	using HashPair   = Pair<BF::Hash>;
+	using SeededPair = Pair<BF::SeededHash>;
+	const std::vector<HashPair>   hashPairs   = MakeCollidingPairs<BF::Hash>(PairCount);
+	const std::vector<SeededPair> seededPairs = MakeCollidingPairs<BF::SeededHash>(PairCount);
+
+	BenchmarkHasher<std::hash<HashPair>>         ("FNV colliding pairs, std::hash",                    hashPairs);
+	BenchmarkHasher<BF::SeededHasher<HashPair>>  ("FNV colliding pairs, SeededHasher",                 hashPairs);
+	BenchmarkHasher<BF::SeededHasher<SeededPair>>("FNV colliding pairs, BF::SeededHash, SeededHasher", seededPairs);
+}
+
+
+}	// namespace
@@ -0,0 +1,157 @@
+#include "BF/StableHash.hpp"
+
+#include <array>
+#include <list>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BF/FlatHashMap.hpp"
+#include "BF/TestUtils.hpp"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+struct IndexHeader {
+	UInt64 seed;													// stored in the file, together with the buckets
+	UInt64 bucketCount;
+};
+
+
+TEST(StableHash, Usage)
+{
+	const IndexHeader header = { 0x1234, 1024 };
+
+	const std::vector<UInt32> parts = { 1, 2, 3 };
+	const UInt64              hash  = BF::StableHash(header.seed, "key", BF::HashRange(parts)).GetValue();
+
+	// The bucket of "key" is the same in every process, which maps the file.
+	EXPECT_EQ(hash % header.bucketCount, BF::StableHash(0x1234, std::string("key"), BF::HashRange(parts)).GetValue() % 1024);
+}
+
+
+// === class StableHash ================================================================================================
+
+static_assert(BF::StableHash(0, 1) == BF::StableHash(0, 1));
+static_assert(BF::StableHash(0, 1) != BF::StableHash(1, 1));				// the seed matters
+static_assert(BF::StableHash(0, 1, 2) != BF::StableHash(0, 2, 1));
+static_assert(BF::StableHash(0, Int32(-1)) == BF::StableHash(0, Int64(-1)));
+static_assert(BF::StableHash(0, UInt8(7)) == BF::StableHash(0, UInt64(7)));
+
+enum class Color { Red, Green };
+static_assert(BF::StableHash(0, Color::Green) == BF::StableHash(0, 1));
+
+// BF::StableHash BF_DUMMY{ 0, 1.0 };										// [CompilationError]: 'Type' is not stable hashable.
+
+
+TEST(StableHash, Stable)										// the values must never change, they are stored in files
+{
+	EXPECT_EQ(BF::StableHash(0).GetValue(), 0xba59cfb56daa4056);
+	EXPECT_EQ(BF::StableHash(0, 42).GetValue(), 0x45464410d42abdc6);
+	EXPECT_EQ(BF::StableHash(12345, 42).GetValue(), 0xbb3c7beb41e28238);
+	EXPECT_EQ(BF::StableHash(0, "").GetValue(), 0x80b8fc451dab25f8);
+	EXPECT_EQ(BF::StableHash(0, "stable").GetValue(), 0xc36a265b2cc3e34b);
+
+	const std::string_view longStr = "a string longer than 48 bytes, which uses all three lanes";
+	EXPECT_EQ(BF::StableHash(7, longStr).GetValue(), 0x73378f8ba3ba5c91);
+}
+
+
+TEST(StableHash, StableRangesAndMemory)							// the same
+{
+	std::vector<UInt32> vec(1000);
+	for (std::size_t i = 0; i < vec.size(); i++)
+		vec[i] = static_cast<UInt32>(i * i);
+
+	const std::list<UInt32> list(vec.begin(), vec.end());
+
+	std::array<UInt8, 300> bytes;
+	for (std::size_t i = 0; i < bytes.size(); i++)
+		bytes[i] = static_cast<UInt8>(i * 7);
+
+	EXPECT_EQ(BF::StableHash(0, BF::HashRange(vec)).GetValue(), 0x660c75c050e3b026);
+	EXPECT_EQ(BF::StableHash(0, BF::HashRange(vec, BF::HashSampleSplitMix())).GetValue(), 0x177e47c78fbccb08);
+	EXPECT_EQ(BF::StableHash(0, BF::HashRange(vec, BF::HashSampleStride())).GetValue(), 0x17c6bce0e3464a9c);
+	EXPECT_EQ(BF::StableHash(0, BF::HashRange(vec, BF::HashSampleLog())).GetValue(), 0x1b4c15c7625f9a31);
+	EXPECT_EQ(BF::StableHash(0, BF::HashRange(vec, BF::HashAll())).GetValue(), 0xb0e4e7ba34b6a9fc);
+	EXPECT_EQ(BF::StableHash(0, BF::HashRange(list)).GetValue(), 0x660c75c050e3b026);
+	EXPECT_EQ(BF::StableHash(0, BF::HashRange(list, BF::HashAll())).GetValue(), 0xb0e4e7ba34b6a9fc);
+	EXPECT_EQ(BF::StableHash(0, BF::HashRawMemory(bytes.data(), bytes.size())).GetValue(), 0x1baa54e99623c0ab);
+}
+
+
+TEST(StableHash, SeedNotErased)
+{
+	constexpr UInt64 Secret0 = 0xa0761d6478bd642f;				// a word that used to cancel the seed
+
+	std::unordered_set<UInt64> hashes;
+	for (UInt64 seed = 0; seed < 1000; seed++)
+		hashes.insert(BF::StableHash(seed, Secret0, 1, 0).GetValue());
+
+	EXPECT_EQ(hashes.size(), 1000u);
+}
+
+
+TEST(StableHash, Strings)
+{
+	const std::string str = "identifier";
+
+	EXPECT_EQ(BF::StableHash(0, str), BF::StableHash(0, std::string_view(str)));
+	EXPECT_EQ(BF::StableHash(0, str), BF::StableHash(0, str.c_str()));
+	EXPECT_NE(BF::StableHash(0, str), BF::StableHash(1, str));
+	EXPECT_NE(BF::StableHash(0, "ab", "c"), BF::StableHash(0, "a", "bc"));
+}
+
+
+TEST(StableHash, Range)
+{
+	std::vector<UInt16>      vec(100);
+	std::array<UInt16, 100>  array = {};
+	std::vector<std::string> strings = { "a", "b" };
+
+	EXPECT_EQ(BF::StableHash(0, BF::HashRange(vec)), BF::StableHash(0, BF::HashRange(array)));
+	EXPECT_NE(BF::StableHash(0, BF::HashRange(vec)), BF::StableHash(0, BF::HashRange(std::span(vec).first(99))));
+	EXPECT_NE(BF::StableHash(0, BF::HashRange(strings)), BF::StableHash(0, "a", "b"));
+
+	vec[0] = 1;
+	EXPECT_NE(BF::StableHash(0, BF::HashRange(vec)), BF::StableHash(0, BF::HashRange(array)));
+
+	vec[0]  = 0;
+	vec[50] = 1;													// not sampled, only 'BF::HashAll' sees it
+	EXPECT_EQ(BF::StableHash(0, BF::HashRange(vec)), BF::StableHash(0, BF::HashRange(array)));
+	EXPECT_NE(BF::StableHash(0, BF::HashRange(vec, BF::HashAll())), BF::StableHash(0, BF::HashRange(array, BF::HashAll())));
+
+	const std::list<UInt16> list(vec.begin(), vec.end());
+	EXPECT_EQ(BF::StableHash(0, BF::HashRange(list)), BF::StableHash(0, BF::HashRange(vec)));
+	EXPECT_EQ(BF::StableHash(0, BF::HashRange(list, BF::HashAll())), BF::StableHash(0, BF::HashRange(vec, BF::HashAll())));
+}
+
+
+TEST(StableHash, RawMemory)
+{
+	const char str[] = "raw bytes";
+
+	EXPECT_EQ(BF::StableHash(0, BF::HashRawMemory(str, sizeof(str) - 1)), BF::StableHash(0, std::string_view(str)));
+	EXPECT_NE(BF::StableHash(0, BF::HashRawMemory(str)), BF::StableHash(0, std::string_view(str)));		// with the '\0'
+}
+
+
+// === class StableHasher ==============================================================================================
+
+TEST(StableHash, Hasher)
+{
+	using Hasher = BF::StableHasher<99>;
+
+	EXPECT_EQ(Hasher()(std::string("x")), Hasher()(std::string_view("x")));
+	EXPECT_EQ(Hasher()(5), BF::StableHash(99, 5).GetValue());
+
+	BF::FlatHashMap<std::string, int, Hasher, std::equal_to<>> map;
+	map["one"] = 1;
+	EXPECT_EQ(map.Find(std::string_view("one"))->second, 1);
+}
+
+
+}	// namespace
@@ -0,0 +1,165 @@
+#include "BF/StaticMap.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "gtest/gtest.h"
+
+
+namespace {
+
+
+// === Usage example ===================================================================================================
+
+enum class Command { Open, Close, Read, Write };
+
+
+constexpr auto Commands = BF::MakeStaticMap<std::string_view, Command>({
+	{ "open",  Command::Open  },
+	{ "close", Command::Close },
+	{ "read",  Command::Read  },
+	{ "write", Command::Write },
+});
+
+
+static_assert(Commands.GetSize() == 4);
+static_assert(*Commands.Find("read") == Command::Read);					// compile time lookup
+static_assert(Commands.Find("seek") == nullptr);
+static_assert(Commands.Contains("open"));
+static_assert(!Commands.Contains(""));
+
+
+constexpr BF::StaticMap<int, int, 3> Squares({ { 1, 1 }, { 2, 4 }, { 3, 9 } });
+
+static_assert(*Squares.Find(3) == 9);
+static_assert(!Squares.Contains(4));
+
+// constexpr BF::StaticMap<int, int, 2> BF_DUMMY({ { 1, 1 }, { 1, 2 } });	// [CompilationError]: expression did not evaluate to a constant
+
+
+// === class StaticMap =================================================================================================
+
+template <std::size_t N>
+void TestStaticMap()
+{
+	std::array<std::pair<std::string_view, std::size_t>, N> entries;
+	std::vector<std::string>                                 keys(N);
+
+	for (std::size_t i = 0; i < N; i++) {
+		keys[i]    = "key" + std::to_string(i * 7919);
+		entries[i] = { keys[i], i };
+	}
+
+	const BF::StaticMap<std::string_view, std::size_t, N> map(entries);		// runtime construction works too
+
+	for (std::size_t i = 0; i < N; i++) {
+		ASSERT_NE(map.Find(keys[i]), nullptr);
+		EXPECT_EQ(*map.Find(keys[i]), i);
+	}
+
+	for (std::size_t i = 0; i < N; i++)
+		EXPECT_FALSE(map.Contains("missing" + std::to_string(i)));
+
+	std::size_t count = 0;
+	for (const auto& [key, value] : map)
+		count += (*map.Find(key) == value);
+	EXPECT_EQ(count, N);
+}
+
+
+TEST(StaticMap, Sizes)
+{
+	TestStaticMap<1>();
+	TestStaticMap<2>();
+	TestStaticMap<16>();
+	TestStaticMap<100>();
+	TestStaticMap<1024>();
+	TestStaticMap<4096>();
+}
+
+
+TEST(StaticMap, IntegerKeys)
+{
+	std::array<std::pair<UInt64, int>, 256> entries;
+	for (std::size_t i = 0; i < entries.size(); i++)
+		entries[i] = { i << 32, int(i) };										// only the high bits differ
+
+	const BF::StaticMap map(entries);
+	for (std::size_t i = 0; i < entries.size(); i++)
+		EXPECT_EQ(*map.Find(i << 32), int(i));
+
+	EXPECT_FALSE(map.Contains(1));
+}
+
+
+// === Benchmark =======================================================================================================
+// Not run by default, run it with '--gtest_also_run_disabled_tests --gtest_filter=*StaticMap*Benchmark'. For 16 to 4096
+// string keys, it prints the time of one lookup of a present and of a missing key, in 'StaticMap', 'std::unordered_map'
+// and 'std::map'.
+
+// Returns the time of one 'find(key)' in ns, for every key in 'keys', 'roundCount' times.
+template <class Find>
+double MeasureLookups(const std::vector<std::string>& keys, bool present, std::size_t roundCount, Find&& find)
+{
+	std::size_t sink  = 0;
+	const auto  start = std::chrono::steady_clock::now();
+	for (std::size_t round = 0; round < roundCount; round++) {
+		for (const std::string& key : keys)
+			sink += find(std::string_view(key));
+	}
+
+	const std::chrono::duration<double, std::nano> time = std::chrono::steady_clock::now() - start;
+	EXPECT_EQ(sink, present ? keys.size() * roundCount : 0);
+	return time.count() / static_cast<double>(keys.size() * roundCount);
+}
+
+
+template <std::size_t N>
+void BenchmarkStaticMap()
+{
+	constexpr std::size_t LookupCount = 10'000'000;
+
+	std::array<std::pair<std::string_view, std::size_t>, N> entries;
+	std::vector<std::string>                                 keys(N);
+	std::vector<std::string>                                 missingKeys(N);
+	for (std::size_t i = 0; i < N; i++) {
+		keys[i]        = "key" + std::to_string(i * 7919);
+		missingKeys[i] = "missing" + std::to_string(i * 7919);
+		entries[i]     = { keys[i], i };
+	}
+
+	const BF::StaticMap<std::string_view, std::size_t, N>      staticMap(entries);
+	const std::unordered_map<std::string_view, std::size_t>    unorderedMap(entries.begin(), entries.end());
+	const std::map<std::string_view, std::size_t, std::less<>> map(entries.begin(), entries.end());
+
+	const auto findStatic    = [&](std::string_view key) { return staticMap.Find(key) != nullptr; };
+	const auto findUnordered = [&](std::string_view key) { return unorderedMap.contains(key); };
+	const auto findOrdered   = [&](std::string_view key) { return map.contains(key); };
+
+	const std::size_t roundCount = LookupCount / N;
+	for (const bool present : { true, false }) {
+		const std::vector<std::string>& lookupKeys = present ? keys : missingKeys;
+
+		const double staticTime    = MeasureLookups(lookupKeys, present, roundCount, findStatic);
+		const double unorderedTime = MeasureLookups(lookupKeys, present, roundCount, findUnordered);
+		const double orderedTime   = MeasureLookups(lookupKeys, present, roundCount, findOrdered);
+		std::printf("%5zu keys, %-5s %6.1f ns StaticMap %6.1f ns std::unordered_map %6.1f ns std::map\n", N,
+					present ? "hit:" : "miss:", staticTime, unorderedTime, orderedTime);
+	}
+}
+
+
+TEST(StaticMap, DISABLED_Benchmark)
+{
+	BenchmarkStaticMap<16>();
+	BenchmarkStaticMap<64>();
+	BenchmarkStaticMap<256>();
+	BenchmarkStaticMap<1024>();
+	BenchmarkStaticMap<4096>();
+}
+
+
+}	// namespace
@@ -278,3 +278,16 @@ BF_COMPILE_TIME_TEST()
 //	BF::AssertTrivialCopyMoveDtor<AssRR>();		// [CompilationError]: static assertion failed: 'std::is_trivially_assignable_v<Type&, Type&>'
 //	BF::AssertTrivialCopyMoveDtor<AssCRR>();	// [CompilationError]: static assertion failed: 'std::is_trivially_assignable_v<Type&, const Type&&>'
 }
+
+
+// === MakeRandomBytes() ===============================================================================================
+
+TEST(TestUtils, MakeRandomBytes)
+{
+	EXPECT_EQ(BF::MakeRandomBytes(100, 1).size(), 100u);
+	EXPECT_EQ(BF::MakeRandomBytes(100, 1), BF::MakeRandomBytes(100, 1));			// deterministic
+	EXPECT_NE(BF::MakeRandomBytes(100, 1), BF::MakeRandomBytes(100, 2));
+
+	for (const std::byte byte : BF::MakeRandomBytes(100, 1, 4))
+		EXPECT_LT(static_cast<unsigned>(byte), 4u);
+}
@@ -0,0 +1,157 @@
+#include "BF/TreeHash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "BF/TestUtils.hpp"
+
+
+namespace {
+
+
+using BF::ImpHash::TreeLeafSize;
+using BF::ImpHash::TreeLeafElementCount;
+
+
+// === Usage example ===================================================================================================
+
+TEST(TreeHash, Usage)
+{
+	const std::vector<std::byte> bytes = BF::MakeRandomBytes(16 << 20, 1);	// e.g. a large file in memory
+
+	const UInt64 hash = BF::TreeHash(bytes);							// on all hardware threads
+	EXPECT_EQ(hash, BF::TreeHash(bytes, 1));
+}
+
+
+// === RunParallel() ===================================================================================================
+
+TEST(TreeHash, RunParallel)
+{
+	for (unsigned threadCount : { 0, 1, 2, 7, 100 }) {
+		for (std::size_t taskCount : { 0, 1, 5, 1000 }) {
+			std::vector<std::atomic<int>> calls(taskCount);
+			BF::ImpHash::RunParallel(taskCount, threadCount, [&](std::size_t i) { calls[i]++; });
+
+			for (const std::atomic<int>& count : calls)
+				EXPECT_EQ(count, 1);
+		}
+	}
+}
+
+
+TEST(TreeHash, RunParallelNestedAndConcurrent)
+{
+	constexpr std::size_t TaskCount = 20;
+
+	const auto runNested = [] {
+		std::vector<std::atomic<int>> calls(TaskCount * TaskCount);
+		BF::ImpHash::RunParallel(TaskCount, 4, [&](std::size_t i) {
+			BF::ImpHash::RunParallel(TaskCount, 4, [&](std::size_t j) { calls[i * TaskCount + j]++; });
+		});
+
+		return std::ranges::all_of(calls, [](const std::atomic<int>& count) { return count == 1; });
+	};
+
+	std::vector<std::thread> threads;
+	std::atomic<int>         successCount = 0;
+	for (int i = 0; i < 4; i++)
+		threads.emplace_back([&] { successCount += runNested(); });
+
+	for (std::thread& thread : threads)
+		thread.join();
+
+	EXPECT_EQ(successCount, 4);
+
+	for (int i = 0; i < 1000; i++)									// the worker threads are reused
+		ASSERT_TRUE(runNested());
+}
+
+
+// === TreeHash() ======================================================================================================
+
+TEST(TreeHash, SameForAllThreadCounts)
+{
+	const std::vector<std::byte> bytes = BF::MakeRandomBytes(5 * TreeLeafSize + 7, 2);
+
+	for (std::size_t size : { std::size_t(0), std::size_t(1), TreeLeafSize - 1, TreeLeafSize, TreeLeafSize + 1, bytes.size() }) {
+		const std::span<const std::byte> data = std::span(bytes).first(size);
+
+		const UInt64 hash = BF::TreeHash(data, 1);
+		for (unsigned threadCount : { 0, 2, 3, 8 })
+			EXPECT_EQ(BF::TreeHash(data, threadCount), hash) << "size: " << size << ", threads: " << threadCount;
+	}
+}
+
+
+TEST(TreeHash, Leaves)
+{
+	const std::vector<std::byte> bytes = BF::MakeRandomBytes(3 * TreeLeafSize + 100, 3);
+
+	std::vector<UInt64> leafHashes;
+	for (std::size_t begin = 0; begin < bytes.size(); begin += TreeLeafSize)
+		leafHashes.push_back(BF::HashBytes(std::span(bytes).subspan(begin, std::min(TreeLeafSize, bytes.size() - begin))));
+
+	EXPECT_EQ(BF::TreeHash(bytes), BF::ImpHash::CombineTreeLeaves(leafHashes, bytes.size()));
+}
+
+
+TEST(TreeHash, EveryLeafMatters)
+{
+	std::vector<std::byte> bytes = BF::MakeRandomBytes(4 * TreeLeafSize, 4);
+
+	std::unordered_set<UInt64> hashes = { BF::TreeHash(bytes) };
+	for (std::size_t leaf = 0; leaf < 4; leaf++) {
+		bytes[leaf * TreeLeafSize + 1000] ^= std::byte(1);
+		hashes.insert(BF::TreeHash(bytes));
+		bytes[leaf * TreeLeafSize + 1000] ^= std::byte(1);
+	}
+
+	EXPECT_EQ(hashes.size(), 5u);
+
+	const std::vector<UInt64> leaves  = { 1, 2 };						// the order of the leaves matters
+	const std::vector<UInt64> swapped = { 2, 1 };
+	EXPECT_NE(BF::ImpHash::CombineTreeLeaves(leaves, 10), BF::ImpHash::CombineTreeLeaves(swapped, 10));
+}
+
+
+TEST(TreeHash, Ranges)
+{
+	std::vector<UInt32> ints(3 * TreeLeafSize / sizeof(UInt32) + 5);
+	for (std::size_t i = 0; i < ints.size(); i++)
+		ints[i] = static_cast<UInt32>(i);
+
+	EXPECT_EQ(BF::TreeHash(ints), BF::TreeHash(std::as_bytes(std::span(ints))));		// hashed as bytes
+
+	std::vector<std::string> strings(2 * TreeLeafElementCount + 3);
+	for (std::size_t i = 0; i < strings.size(); i++)
+		strings[i] = std::to_string(i);
+
+	const UInt64 hash = BF::TreeHash(strings, 1);
+	EXPECT_EQ(BF::TreeHash(strings, 4), hash);
+
+	strings[TreeLeafElementCount + 10] = "x";							// every element is hashed
+	EXPECT_NE(BF::TreeHash(strings), hash);
+}
+
+
+TEST(TreeHash, StaticExtent)
+{
+	std::array<UInt32, 1000> ints;
+	for (std::size_t i = 0; i < ints.size(); i++)
+		ints[i] = static_cast<UInt32>(i);
+
+	const std::span<const std::byte, sizeof(ints)> bytes = std::as_bytes(std::span(ints));
+
+	EXPECT_EQ(BF::TreeHash(ints), BF::TreeHash(std::span<const std::byte>(bytes)));
+	EXPECT_EQ(BF::TreeHash(bytes), BF::TreeHash(std::span<const std::byte>(bytes)));
+	EXPECT_EQ(BF::TreeHash(std::span(ints)), BF::TreeHash(ints));
+}
+
+
+}	// namespace